@@ -1,15 +1,171 @@
 #pragma once
 
+#include "common/RuntimeProfile.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+// API credentials and REST endpoint for one venue ("binance"/"bybit" objects).
+struct VenueCredentials {
+    std::string apiKey;
+    std::string secret;
+    std::string restUrl;
+};
+
+// Order rate limit for one venue: a token bucket refilled at ordersPerSec.
+struct RateLimit {
+    double ordersPerSec = 0.0;  // 0 = unlimited
+    double burst = 0.0;         // Bucket size; 0 = ordersPerSec (one second's worth)
+};
+
+// Pre-trade risk limits ("risk" object). A limit of 0 disables that check.
+struct RiskLimits {
+    double maxOrderUsd = 0.0;          // Max notional of a single order.
+    double maxSymbolGrossUsd = 0.0;    // Max sum of |position| across venues, per symbol.
+    double maxSymbolNetUsd = 0.0;      // Max |sum of positions| across venues, per symbol.
+    double maxGrossUsd = 0.0;          // Max gross exposure over all symbols.
+    double maxNetUsd = 0.0;            // Max |net exposure| over all symbols.
+    double maxLossUsd = 0.0;           // Kill switch: stop trading once cumulative PnL <= -maxLossUsd.
+    double duplicateWindowMs = 0.0;    // Reject an order identical to one sent this recently.
+    RateLimit rate;                    // Default per-venue order rate.
+    std::map<std::string, RateLimit> venueRates; // Overrides by exchange name.
+};
+
+// Inventory unwinding ("rebalance" object; the spread threshold is rebalanceMinSpread).
+struct RebalanceSettings {
+    double minUnwindUsd = 50.0;     // Smaller unwinds wait for more inventory (unless it blocks trading).
+    double maxUnwindUsd = 0.0;      // Cap per unwind (0 = none).
+};
+
+// Automatic symbol discovery ("universe" object).
+struct UniverseSettings {
+    bool enabled = false;           // Trade every perpetual listed on both venues instead of "symbols".
+    std::string quote = "USDT";     // Quote asset of the contracts to include.
+    size_t maxSymbols = 0;          // Keep at most this many (0 = all).
+    std::string binanceFixture;     // Read Binance exchangeInfo from this file instead of REST.
+    std::string bybitFixture;       // Read Bybit instruments-info from this file instead of REST.
+    size_t subscribeBatch = 50;     // Symbols per websocket connection.
+    double readyTimeoutSec = 10.0;  // How long startup waits for every book's first update.
+};
+
+// Startup sequence ("startup" object); see StartupSequence.
+struct StartupSettings {
+    double readyTimeoutSec = 10.0;  // How long to wait for every venue/symbol book (default: universe.readyTimeoutSec).
+    size_t warmUpRounds = 100;      // Dry scans over every symbol before trading (0 = none).
+    bool prefault = true;           // Touch books, pools and buffers before trading instead of on first use.
+};
+
+// Tick history recording ("tickStore" object).
+struct TickStoreSettings {
+    bool enabled = false;           // Record top-of-book and spread changes to disk.
+    std::string dir = "ticks";      // Root directory; files go to <dir>/<YYYYMMDD>/<SYMBOL>.<table>.tks
+    bool compress = true;           // zlib-compress chunks (kept raw when that is not smaller).
+    size_t chunkRows = 4096;        // Rows per table buffered before a chunk is written.
+    double flushIntervalSec = 5.0;  // Write partial chunks at least this often.
+    size_t queueDepth = 65536;      // Engine-to-writer queue; rows are dropped (and counted) when full.
+};
+
+// Local control socket ("admin" object).
+struct AdminSettings {
+    bool enabled = false;                     // Serve operator commands on a Unix-domain socket.
+    std::string socketPath = "arbitrage.sock"; // Created with owner-only permissions.
+};
+
+// Immutable view of the configuration at one point in time.
+// A published snapshot is never modified or freed, so readers may keep the pointer.
+struct ConfigSnapshot {
+    uint64_t version = 0;                   // Increments with every published snapshot.
+    std::vector<std::string> symbols;       // Trading symbols.
+    std::string mode = "paper";             // "paper" or "live".
+    double feesPercent = 0.04;              // Paper trading fee percent.
+    double maxPosUsd = 1000.0;              // Max USD position per exchange per symbol.
+    double minSpreadPercent = 0.05;         // Minimum spread percent for arbitrage.
+    double rebalanceMinSpread = 0.02;       // Minimum spread for rebalancing.
+    double checkIntervalSeconds = 1;        // Interval for checking arbitrage.
+
+    // Depth- and latency-aware paper fills ("paperSim" object).
+    bool paperSimEnabled = false;           // Fill against book depth instead of the reference price.
+    double paperLatencyMs = 0.0;            // Simulated send-to-match latency.
+    size_t paperDepthLevels = 20;           // Book levels visible to the simulator.
+    double paperSlippagePct = 0.05;         // Worst fill price allowed vs reference, in percent.
+
+    // Rolling spread statistics ("adaptiveThreshold" object, "statsLogIntervalSec").
+    bool adaptiveThreshold = false;         // Raise the entry threshold to ewma + k * stddev per venue pair.
+    double adaptiveStddevMult = 2.0;        // k in the formula above.
+    uint64_t adaptiveMinSamples = 100;      // Samples required before the adaptive threshold applies.
+    double statsLogIntervalSec = 60.0;      // How often spread statistics are logged (0 = never).
+
+    // Live trading ("binance"/"bybit" credentials, "live" object).
+    VenueCredentials binance{ "", "", "https://fapi.binance.com" };
+    VenueCredentials bybit{ "", "", "https://api.bybit.com" };
+    int liveRecvWindowMs = 5000;            // Signed request validity window.
+    double liveKeepAliveSec = 30.0;         // Ping idle order connections after this long (0 = never).
+    int liveTimeoutMs = 2000;               // Connect/request limit for order connections (0 = none).
+
+    // Thread pinning, busy-poll and memory settings ("runtime" object). Applied at startup;
+    // busyPoll/pauseBackoff also follow reloads.
+    RuntimeSettings runtime;
+
+    // Symbol discovery and batched subscription ("universe" object). Startup only.
+    UniverseSettings universe;
+
+    // Readiness barrier, pre-faulting and warm-up before trading ("startup" object). Startup only.
+    StartupSettings startup;
+
+    // Pre-trade risk checks ("risk" object).
+    RiskLimits risk;
+
+    // Inventory unwinding ("rebalance" object).
+    RebalanceSettings rebalance;
+
+    // Book-builder pipeline between socket threads and books ("pipeline" object). Startup only.
+    PipelineSettings pipeline;
+
+    // Tick history recording ("tickStore" object). Startup only.
+    TickStoreSettings tickStore;
+
+    // Operator control socket ("admin" object). Startup only.
+    AdminSettings admin;
+};
+
 // Manages loading and accessing configuration parameters.
+// Every load/reload publishes a new ConfigSnapshot (RCU style): readers pick up
+// the current one with a single atomic pointer load and never take a lock.
 class ConfigManager {
 public:
-    // Loads configuration (default: "config.json").
+    // Loads configuration (default: "config.json") and publishes it. Throws on error.
     static void load(const std::string& filePath = "config.json");
 
-    // Getters for configuration parameters.
+    // Vets a reloaded snapshot against the current one: returns why it is
+    // rejected, or an empty string. Runs under the writer lock; must not call back in.
+    using ReloadCheck = std::function<std::string(const ConfigSnapshot& current, const ConfigSnapshot& next)>;
+
+    // Re-reads the file passed to load(). Returns false (keeping the current
+    // snapshot) if the file cannot be read or parsed, lists more symbols than
+    // can be interned, or `check` rejects it.
+    static bool reload(const ReloadCheck& check = nullptr);
+
+    // Publishes a new snapshot; its version is assigned here.
+    static const ConfigSnapshot* publish(ConfigSnapshot next);
+
+    // Publishes a copy of the current snapshot changed by `edit`. Runs under the
+    // writer lock, so no reload or other update lands between the read and the publish.
+    static const ConfigSnapshot* update(const std::function<void(ConfigSnapshot&)>& edit);
+
+    // Replaces the configured symbol list (e.g. with a discovered universe) and
+    // keeps it across reloads.
+    static void overrideSymbols(std::vector<std::string> symbols);
+
+    // Returns the current snapshot (never null).
+    static const ConfigSnapshot* snapshot() { return current_.load(std::memory_order_acquire); }
+
+    // Getters for configuration parameters (read from the current snapshot).
     static std::vector<std::string> getSymbols();           // Returns trading symbols.
     static std::string getMode();                           // Returns mode (e.g., "paper", "live").
     static double getFeesPercent();                         // Returns paper trading fee percent.
@@ -19,12 +175,15 @@ public:
     static double getCheckIntervalSeconds();                // Returns interval for checking arbitrage.
 
 private:
-    // Cached configuration values.
-    static std::vector<std::string> symbols_;
-    static std::string mode_;
-    static double feesPercent_;
-    static double maxPosUsd_;
-    static double minSpreadPercent_;
-    static double rebalanceMinSpread_;
-    static double checkIntervalSeconds_;
+    // Parses a config file into a snapshot. Throws on error.
+    static ConfigSnapshot parse(const std::string& filePath);
+
+    // publish() for callers holding publishMutex_.
+    static const ConfigSnapshot* publishLocked(ConfigSnapshot next);
+
+    static std::atomic<const ConfigSnapshot*> current_;
+    static std::vector<std::unique_ptr<const ConfigSnapshot>> published_; // Keeps every snapshot alive
+    static std::mutex publishMutex_;                                       // Serializes writers only
+    static std::string filePath_;
+    static std::vector<std::string> symbolOverride_;                       // Used when non-empty (under publishMutex_)
 };
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common/ConfigManager.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Reloads the configuration on SIGHUP or when the config file changes on disk.
+// Runs on its own thread; the callback is invoked there after each successful reload.
+class ConfigWatcher {
+public:
+    using ReloadCallback = std::function<void(const ConfigSnapshot& prev, const ConfigSnapshot& next)>;
+
+    // Symbols a reload adds and removes, each in list order.
+    struct SymbolDiff {
+        std::vector<std::string> added;
+        std::vector<std::string> removed;
+    };
+
+    ConfigWatcher(std::string filePath, ReloadCallback onReload, double pollIntervalSec = 1.0);
+    ~ConfigWatcher();
+
+    // Reloads that `check` rejects are not published (see ConfigManager::reload). Call before start().
+    void setReloadCheck(ConfigManager::ReloadCheck check) { check_ = std::move(check); }
+
+    static SymbolDiff diffSymbols(const ConfigSnapshot& prev, const ConfigSnapshot& next);
+
+    // Installs the SIGHUP handler and starts the watcher thread.
+    void start();
+
+    // Stops the watcher thread.
+    void stop();
+
+private:
+    void run();
+
+    // Returns true if the file's modification time changed since the last check.
+    bool fileChanged();
+
+    std::string filePath_;
+    ReloadCallback onReload_;
+    ConfigManager::ReloadCheck check_;
+    double pollIntervalSec_;
+    std::filesystem::file_time_type lastWrite_{};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string_view>
+
+typedef struct evp_mac_st EVP_MAC;
+typedef struct evp_mac_ctx_st EVP_MAC_CTX;
+
+// HMAC-SHA256 signer with a reusable OpenSSL context keyed once at construction.
+// Signing does not allocate. Not thread-safe: one instance per signing thread.
+class HmacSha256 {
+public:
+    explicit HmacSha256(std::string_view key);
+    ~HmacSha256();
+
+    HmacSha256(const HmacSha256&) = delete;
+    HmacSha256& operator=(const HmacSha256&) = delete;
+
+    // Incremental signing: begin(), any number of update(), then finishHex().
+    bool begin();
+    bool update(std::string_view data);
+
+    // Writes the lowercase hex digest into out[0..63] (not NUL-terminated).
+    bool finishHex(char* out);
+
+    // One-shot helper for a single buffer.
+    bool signHex(std::string_view data, char* out) { return begin() && update(data) && finishHex(out); }
+
+    static constexpr size_t kHexSize = 64;
+
+private:
+    EVP_MAC* mac_ = nullptr;
+    EVP_MAC_CTX* ctx_ = nullptr;
+};
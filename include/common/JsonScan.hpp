@@ -0,0 +1,8 @@
+#pragma once
+
+#include <string_view>
+
+// Returns the raw value of the first "key": in a JSON text (quotes stripped), or
+// empty. A scan, not a parser: meant for flat objects or leading fields such as a
+// websocket message's "stream"/"topic", where a full parse would be wasted.
+std::string_view jsonField(std::string_view json, std::string_view key);
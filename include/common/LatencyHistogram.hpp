@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Log-linear latency histogram (16 sub-buckets per power of two, ~6% resolution).
+// record() is O(1) and allocation-free. Single writer; copy it to read from elsewhere.
+class LatencyHistogram {
+public:
+    void record(int64_t valueNs);
+
+    // Value at quantile q in [0, 1] (upper edge of the matching bucket).
+    int64_t percentile(double q) const;
+
+    uint64_t count() const { return count_; }
+    int64_t max() const { return max_; }
+
+    void reset();
+
+private:
+    static constexpr int kSubBits = 4;
+    static constexpr int kBuckets = (64 - kSubBits + 1) << kSubBits;
+
+    static int bucketFor(uint64_t v);
+    static int64_t bucketUpperEdge(int bucket);
+
+    std::array<uint64_t, kBuckets> buckets_{};
+    uint64_t count_ = 0;
+    int64_t max_ = 0;
+};
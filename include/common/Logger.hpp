@@ -1,10 +1,24 @@
 #pragma once
 
-#include <string>
+#include <string_view>
 
 class Logger {
 public:
-    static void info(const std::string& msg);
-    static void warn(const std::string& msg);
-    static void error(const std::string& msg);
-};
\ No newline at end of file
+    static void info(std::string_view msg);
+    static void warn(std::string_view msg);
+    static void error(std::string_view msg);
+
+    // printf-style variant for hot paths: formats into a thread-local buffer, no heap allocation.
+    static void infof(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 1, 2)))
+#endif
+        ;
+
+    // printf-style warning, formatted like infof.
+    static void warnf(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 1, 2)))
+#endif
+        ;
+};
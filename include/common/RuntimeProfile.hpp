@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Low-latency runtime settings ("runtime" config object).
+struct RuntimeSettings {
+    std::vector<int> feedCores;     // Cores for websocket feed threads (round-robin); empty = unpinned
+    int engineCore = -1;            // Core for the engine thread; -1 = unpinned
+    bool busyPoll = false;          // Spin on book changes instead of sleeping checkIntervalSec
+    bool pauseBackoff = true;       // While busy-polling, back off with CPU pause when idle
+    bool lockMemory = false;        // mlockall() current and future pages at startup
+    bool numaLocal = false;         // Prefer memory on the node of the core a pinned thread runs on
+};
+
+// Feed pipeline settings ("pipeline" config object); see FramePipeline.
+struct PipelineSettings {
+    bool enabled = false;           // false: parse and apply frames on the socket thread
+    size_t builderThreads = 1;      // Book-builder threads
+    std::vector<int> builderCores;  // Cores to pin builder threads to (round-robin); empty = unpinned
+    size_t queueDepth = 64;         // Pooled frame buffers (and ring slots) per channel
+    bool busyPoll = false;          // Builders spin when idle instead of napping (default: runtime.busyPoll)
+    double statsLogIntervalSec = 60.0; // How often builders log queue stats (statsLogIntervalSec); 0 = never
+    bool prefault = true;           // Touch frame buffers when a channel is created (startup.prefault)
+};
+
+// Applies thread placement and memory policy. Linux only; elsewhere the calls
+// log a warning (once) and do nothing.
+class RuntimeProfile {
+public:
+    // Stores the settings and applies process-wide options (memory locking).
+    // Call once at startup, before any feed thread starts.
+    static void configure(const RuntimeSettings& settings);
+
+    // Pins the calling thread to the engine core and applies the memory policy.
+    static void enterEngineThread();
+
+    // Pins the calling feed thread to the next feed core (or moves it off the
+    // engine core when no feed cores are listed). Cheap after the first call on
+    // a thread, so it can run at the top of every message callback.
+    static void enterFeedThread();
+
+    // Moves a housekeeping thread (config watcher, keep-alive, ...) off the
+    // engine and feed cores. Threads inherit their creator's affinity, so
+    // threads spawned from a pinned thread should call this first.
+    static void enterBackgroundThread();
+
+    // Pins the calling thread to `core`. Returns false on failure.
+    static bool pinCurrentThread(int core);
+
+    // CPU hint for spin-wait loops.
+    static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+private:
+    static void applyMemoryPolicy();
+
+    static RuntimeSettings settings_;
+};
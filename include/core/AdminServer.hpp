@@ -0,0 +1,52 @@
+#pragma once
+
+#include "common/ConfigManager.hpp"
+#include "core/ArbitrageEngine.hpp"
+#include "exchange/IExchangeClient.hpp"
+
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Operator control over a Unix-domain socket, served on its own thread. Each
+// request is one text line and gets one JSON line back (send "help" for the list).
+// Reads use the engine's published snapshots and bounded book copies; controls are
+// atomics or requests the engine picks up on its next scan, so nothing here holds
+// engine state or a book lock for longer than a top-of-book copy.
+class AdminServer {
+public:
+    AdminServer(AdminSettings settings, ArbitrageEngine& engine, std::vector<std::shared_ptr<IExchangeClient>> clients);
+    ~AdminServer();
+
+    // Binds the socket (replacing a stale one) and starts serving. Returns false if it cannot bind.
+    bool start();
+    void stop();
+
+    // Executes one command line; exposed for callers that are not on the socket.
+    nlohmann::json execute(const std::string& line);
+
+private:
+    void run();
+    void serve(int fd);
+
+    nlohmann::json help() const;
+    nlohmann::json status() const;
+    nlohmann::json dump(const std::string& symbol, size_t levels) const;
+    nlohmann::json pause(const std::vector<std::string>& args, bool paused);
+    nlohmann::json flatten(const std::string& symbol);
+    nlohmann::json set(const std::string& key, const std::string& value);
+    nlohmann::json resubscribe(const std::string& symbol);
+
+    // Interned id of a configured symbol, or -1.
+    int64_t symbolId(const std::string& symbol) const;
+
+    AdminSettings settings_;
+    ArbitrageEngine& engine_;
+    std::vector<std::shared_ptr<IExchangeClient>> clients_;
+    int listenFd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
@@ -1,54 +1,245 @@
 #pragma once
 
+#include "common/ConfigManager.hpp"
+#include "common/LatencyHistogram.hpp"
+#include "core/ConsolidatedBook.hpp"
+#include "core/Interner.hpp"
+#include "core/OrderPool.hpp"
 #include "core/PaperTrader.hpp"
+#include "core/RebalanceScheduler.hpp"
+#include "core/RiskGate.hpp"
+#include "core/Seqlock.hpp"
+#include "core/SpreadStats.hpp"
 #include "exchange/IExchangeClient.hpp"
+#include "storage/TickStore.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 // Core engine for managing arbitrage logic, positions, and trade execution across multiple exchanges.
 class ArbitrageEngine {
 public:
+    // Per-venue positions and realized PnL of one symbol, as of its last fill.
+    struct PositionSnapshot {
+        std::array<double, kMaxVenues> usd{}; // Signed USD position, indexed by VenueId
+        double pnl = 0.0;                     // Cumulative realized PnL
+    };
+
     void addExchangeClient(const std::shared_ptr<IExchangeClient>& client);
 
     // Registers a trade executor for a specific exchange.
     void addExecutor(const std::string& exchangeName, const std::shared_ptr<ITradeExecutor>& exec);
 
-    void setSymbols(const std::vector<std::string>& symbols);
+    // Quantity increment of `symbol` on an exchange; order quantities are rounded
+    // down to the coarser increment of the two venues traded. Call before start().
+    void setLotSize(const std::string& exchangeName, const std::string& symbol, double lotSize);
+
+    // Records every top-of-book change and venue-pair spread the engine observes. Call before start().
+    void setTickStore(std::shared_ptr<TickStore> store);
 
-    // Sets engine parameters: min spread %, check interval (sec), max USD position, rebalance min spread %.
-    void setConfig(double minSpreadPercent, double checkIntervalSec, double maxPosUsd, double rebalanceMinSpread);
+    // Startup (see StartupSequence), in this order and before start(): builds every symbol's
+    // state and attaches the venue books that exist; then runs `rounds` scans over every
+    // symbol through the full detection and sizing path without sending orders, so the
+    // first live scan does not take the cold misses.
+    void prepare();
+    void warmUp(size_t rounds);
 
+    // Launch time of the process; the first live scan logs its delay from it.
+    void setLaunchTime(std::chrono::steady_clock::time_point launch) { launch_ = launch; }
+
+    // Runs the evaluation loop. Symbols and thresholds follow ConfigManager::snapshot(),
+    // so a reloaded config takes effect on the next scan without a restart. Returns after stop().
     void start();
 
+    // Makes start() return after its current scan; safe from any thread (e.g. a signal handler).
+    void stop() { stopRequested_.store(true, std::memory_order_relaxed); }
+
+    // One pass of that loop without its pacing: config, operator requests, delayed fills,
+    // then every symbol. Returns true if any book changed. Engine thread only.
+    bool scan();
+
+    // Rolling statistics for buying `symbol` on `buyVenue` and selling on `sellVenue`.
+    // Engine thread only (e.g. from within the evaluation loop); returns empty stats for unknown pairs.
+    SpreadStatsSnapshot spreadStats(SymbolId symbol, VenueId buyVenue, VenueId sellVenue) const;
+
+    // Fee-adjusted merged book of every venue for `symbol`; null until the symbol is scanned.
+    // Obtain it on the engine thread; the returned book may then be read from any thread.
+    std::shared_ptr<const ConsolidatedBook> consolidatedBook(SymbolId symbol) const;
+
+    // Book mutation -> engine observation delays since the last stats log.
+    // Engine thread only, or once start() has returned.
+    const LatencyHistogram& detectLatency() const { return detectLatency_; }
+
+    // Operator controls and introspection (see AdminServer); safe from any thread.
+    // Paused symbols and venues keep their statistics but take no new trades.
+    void pauseSymbol(SymbolId symbol, bool paused) { symbolPaused_[symbol].store(paused, std::memory_order_relaxed); }
+    void pauseVenue(VenueId venue, bool paused) { venuePaused_[venue].store(paused, std::memory_order_relaxed); }
+    bool symbolPaused(SymbolId symbol) const { return symbolPaused_[symbol].load(std::memory_order_relaxed); }
+    bool venuePaused(VenueId venue) const { return venuePaused_[venue].load(std::memory_order_relaxed); }
+
+    // Closes every venue position in `symbol` at the venue's top of book, on the engine's next scan.
+    void requestFlatten(SymbolId symbol);
+
+    // Positions and PnL of `symbol`; a lock-free copy of the engine's last publication.
+    PositionSnapshot positions(SymbolId symbol) const { return positions_[symbol].load(); }
+
+    // Merged book of `symbol` for readers on other threads; null until the symbol is scanned.
+    // Books are never destroyed while the engine exists.
+    const ConsolidatedBook* findConsolidatedBook(SymbolId symbol) const {
+        return consolidatedOut_[symbol].load(std::memory_order_acquire);
+    }
+
 private:
     struct ExchangePos {
         double usd = 0.0;
     };
 
-    void checkArbitrage(const std::string& symbol);
+    // An exchange client together with its interned name.
+    struct Venue {
+        std::shared_ptr<IExchangeClient> client;
+        VenueId id = 0;
+    };
+
+    // What a group of orders sent together was for.
+    enum class TradeKind : uint8_t { Entry, Unwind, Flatten };
+
+    // Orders sent together, some of whose fills may still be on their way (Fill::pending).
+    // Entries and unwinds hold { buy, sell }; a flatten holds its one order.
+    struct OpenTrade {
+        TradeKind kind = TradeKind::Entry;
+        SymbolId symbol = 0;
+        uint8_t legs = 0;
+        uint8_t pending = 0;  // Legs whose final fill has not arrived
+        bool active = false;  // Slot in use
+        std::array<Fill, 2> fills{};
+    };
+
+    static constexpr size_t kMaxOpenTrades = 32;
+
+    // Per-symbol engine state. Pair stats are indexed [buyIdx * exchanges_.size() + sellIdx],
+    // where the indices are positions in exchanges_.
+    struct SymbolState {
+        std::vector<SpreadStats> pairs;
+        std::array<uint64_t, kMaxVenues> seenVersion{}; // Last book version seen per exchange index
+        std::shared_ptr<ConsolidatedBook> consolidated;  // Rebuilt from every venue's book when one changes
+        std::array<std::shared_ptr<OrderBook>, kMaxVenues> attached{}; // Books followed, per exchange index
+    };
+
+    // Picks up a newly published config snapshot, if any.
+    void refreshConfig();
+
+    // Updates every venue pair's spread statistics for one symbol from fresh tops.
+    void updateSpreadStats(SymbolId symbol, SymbolState& state, const OrderBook::TopOfBook* tops, const bool* valid, int64_t nowNs);
+
+    // Entry threshold (%) for a venue pair: minSpreadPercent_, raised by the pair's
+    // own spread distribution when adaptive thresholds are enabled.
+    double entryThreshold(const SpreadStats& stats) const;
+
+    // Logs spread statistics for every symbol and venue pair, and feed-to-engine latency.
+    void logSpreadStats();
+
+    // Follows exchange index i's current book for `symbol`, holding a new or resubscribed
+    // book while it is read. Returns null if the venue has no book for it.
+    const OrderBook* attachBook(SymbolId symbol, SymbolState& state, size_t i);
+
+    // Number of (venue, symbol) books with a two-sided top right now.
+    size_t validBooks() const;
+
+    // Reads every venue's book for a symbol, updates statistics and evaluates it.
+    // Returns true if any book changed since the previous call.
+    bool checkArbitrage(SymbolId symbol);
+
+    // Trades one symbol's tops of book: an entry if there is one, otherwise a rebalance.
+    void evaluate(SymbolId symbol, SymbolState& state, const OrderBook::TopOfBook* tops, const bool* valid);
+
+    // Detects and executes an opportunity. Returns true if orders were sent.
+    bool enter(SymbolId symbol, SymbolState& state, const OrderBook::TopOfBook* tops, const bool* valid);
+
+    // Unwinds opposite venue positions when the reverse spread exceeds rebalanceMinSpread_.
+    void rebalance(SymbolId symbol, const OrderBook::TopOfBook* tops, const bool* valid);
 
-    // Returns remaining USD room for a position, given side ("buy"/"sell").
-    double remainingUsdRoom(const std::string& exchangeName, const std::string& symbol, const std::string& side);
+    // Runs operator requests queued from other threads (engine thread).
+    void runControl();
+
+    // Sends closing orders for every venue position in `symbol`, bypassing the risk gate.
+    void flatten(SymbolId symbol);
+
+    // Books the legs of a just-sent trade that are already final and parks it until the
+    // others arrive; a trade with no pending legs completes at once.
+    void track(OpenTrade trade);
+
+    // Drains every executor's delayed fills into their open trades.
+    void collectFills();
+
+    // Books one delayed fill, completing its trade if it was the last leg.
+    void settleLeg(const Fill& fill);
+
+    // Applies a final fill to the risk gate and, if it filled, to the venue position.
+    void applyFill(const Fill& fill);
+
+    // Books PnL and logs the outcome of a trade whose legs are all final.
+    void finishTrade(const OpenTrade& trade);
+
+    // Refreshes what derives from a symbol's positions: the published snapshot and rebalance inventory.
+    void positionsChanged(SymbolId symbol);
+
+    // Returns remaining USD room for a position, given side.
+    double remainingUsdRoom(VenueId venue, SymbolId symbol, Side side) const;
 
     // Updates and returns new USD position after a trade.
-    double applyPositionUpdate(const std::string& exchangeName, const std::string& symbol,
-                             const std::string& side, double executedUsd);
+    double applyPositionUpdate(VenueId venue, SymbolId symbol, Side side, double executedUsd);
 
-    // Generates a unique key for (exchange, symbol) pairs.
-    std::string posKey(const std::string& exchangeName, const std::string& symbol) const { return exchangeName + ":" + symbol; }
+    // Index of an (exchange, symbol) pair in activePositionsUsd_.
+    static size_t posIndex(VenueId venue, SymbolId symbol) { return static_cast<size_t>(symbol) * kMaxVenues + venue; }
 
-    std::vector<std::string> symbols_;
-    std::vector<std::shared_ptr<IExchangeClient>> exchanges_;
-    std::unordered_map<std::string, std::shared_ptr<ITradeExecutor>> executors_;
-    std::unordered_map<std::string, ExchangePos> activePositionsUsd_;
-    std::unordered_map<std::string, double> cumulativePnl_;
+    const ConfigSnapshot* config_ = nullptr; // Snapshot the parameters below were taken from
+    std::vector<SymbolId> symbols_;          // Interned config_->symbols
+    std::vector<Venue> exchanges_;
+    std::array<VenueId, kMaxVenues> venueIds_{}; // exchanges_[i].id, contiguous for ConsolidatedBook::rebuild
+    std::array<std::shared_ptr<ITradeExecutor>, kMaxVenues> executors_{}; // Indexed by VenueId
+    std::vector<ExchangePos> activePositionsUsd_ = std::vector<ExchangePos>(size_t(kMaxSymbols) * kMaxVenues);
+    std::vector<SymbolState> symbolState_;   // Indexed by SymbolId
+    std::vector<double> cumulativePnl_ = std::vector<double>(kMaxSymbols, 0.0); // Indexed by SymbolId
+    std::vector<double> lotSize_ = std::vector<double>(size_t(kMaxSymbols) * kMaxVenues, 0.0); // Indexed by posIndex
+    OrderPool orders_{64};
+    std::array<OpenTrade, kMaxOpenTrades> openTrades_{}; // Trades awaiting delayed fills
+    size_t activeTrades_ = 0;                // Slots in use
+    size_t pendingLegs_ = 0;                 // Fills still expected, over all open trades
+    std::vector<uint8_t> symbolPending_ = std::vector<uint8_t>(kMaxSymbols, 0); // Open trades per SymbolId
+    RiskGate risk_;                          // Pre-trade checks; limits follow the config snapshot
+    RebalanceScheduler rebalancer_;          // Picks inventory unwinds
+    std::shared_ptr<TickStore> tickStore_;   // Optional tick history
+    TickStore* ticks_ = nullptr;             // tickStore_.get(), for the scan loop
 
     // Engine configuration parameters
     double minSpreadPercent_ = 0.05;
     double checkIntervalSec_ = 1.0;
     double maxPosUsd_ = 10000;
     double rebalanceMinSpread_ = 0.01;
+    bool adaptiveThreshold_ = false;
+    double adaptiveStddevMult_ = 2.0;
+    uint64_t adaptiveMinSamples_ = 100;
+    double statsLogIntervalSec_ = 60.0;
+    bool busyPoll_ = false;
+    bool pauseBackoff_ = true;
+    bool warmingUp_ = false;                 // Scans evaluate fully but send nothing (warmUp)
+    std::atomic<bool> stopRequested_{false}; // Set by stop(); ends start()
+    std::chrono::steady_clock::time_point launch_ = std::chrono::steady_clock::now();
+
+    LatencyHistogram detectLatency_;         // Book mutation -> engine observation
+    uint64_t observedVersions_ = 0;          // Book versions the engine evaluated
+    uint64_t conflatedVersions_ = 0;         // Book versions superseded before the engine saw them
+
+    // State shared with operator threads
+    std::unique_ptr<std::atomic<bool>[]> symbolPaused_ = std::make_unique<std::atomic<bool>[]>(kMaxSymbols);
+    std::array<std::atomic<bool>, kMaxVenues> venuePaused_{};
+    std::unique_ptr<std::atomic<bool>[]> flattenRequested_ = std::make_unique<std::atomic<bool>[]>(kMaxSymbols);
+    std::atomic<bool> controlPending_{false};  // Some request above awaits the engine thread
+    std::unique_ptr<Seqlock<PositionSnapshot>[]> positions_ = std::make_unique<Seqlock<PositionSnapshot>[]>(kMaxSymbols);
+    std::unique_ptr<std::atomic<const ConsolidatedBook*>[]> consolidatedOut_ =
+        std::make_unique<std::atomic<const ConsolidatedBook*>[]>(kMaxSymbols);
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "core/OrderBook.hpp"
+#include "core/Types.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Merged L2 view of one symbol across venues. Levels are keyed by fee-adjusted
+// price (bids net of the venue's taker fee, asks gross of it) and carry each
+// venue's quantity. The engine thread rebuilds it from the venue books' top levels
+// when they change, and readers get it through a seqlock, so queries never touch a
+// venue book or its mutex.
+class ConsolidatedBook {
+public:
+    static constexpr size_t kSnapshotLevels = 20; // Levels per side visible to readers
+
+    struct Level {
+        double price = 0.0;                        // Fee-adjusted price
+        double qty = 0.0;                          // Sum over venues
+        std::array<double, kMaxVenues> venueQty{}; // Indexed by VenueId
+    };
+
+    // Top of the merged book: bids best (highest) first, asks best (lowest) first.
+    struct Snapshot {
+        uint64_t version = 0;
+        size_t bidCount = 0;
+        size_t askCount = 0;
+        std::array<Level, kSnapshotLevels> bids;
+        std::array<Level, kSnapshotLevels> asks;
+    };
+
+    // Liquidity where the merged best bid exceeds the merged best ask, after fees.
+    struct CrossedRegion {
+        double qty = 0.0;         // Quantity that can be bought low and sold high
+        double buyCost = 0.0;     // Fee-adjusted cost of buying qty on the ask side
+        double sellProceeds = 0.0; // Fee-adjusted proceeds of selling qty on the bid side
+        size_t bidLevels = 0;     // Bid levels touched
+        size_t askLevels = 0;     // Ask levels touched
+
+        double edge() const { return sellProceeds - buyCost; }
+    };
+
+    ConsolidatedBook();
+
+    // Taker fee (percent) used to adjust `venue`'s prices from the next rebuild on.
+    void setFeePercent(VenueId venue, double feePct);
+
+    // Merges the top levels of `count` venue books (null entries are skipped) and
+    // publishes them if they differ from the last publication. One writer thread only.
+    void rebuild(const OrderBook* const* books, const VenueId* venues, size_t count);
+
+    // Copies the latest published top levels without blocking writers.
+    void read(Snapshot& out) const;
+
+    // Walks both sides of a snapshot from the top; O(levels crossed).
+    static CrossedRegion crossedRegion(const Snapshot& snap);
+
+    // Total quantity on one side at or better than a fee-adjusted limit (Buy reads asks).
+    static double liquidity(const Snapshot& snap, Side side, double limitPrice);
+
+private:
+    // Merges the scratch lists of one side into `out`, best price first; returns the level count.
+    size_t merge(const std::array<std::vector<OrderBook::PriceLevel>, kMaxVenues>& sides, const VenueId* venues,
+                 size_t count, bool bids, std::array<Level, kSnapshotLevels>& out) const;
+
+    // Copies staging_ to published_ under the seqlock.
+    void publish();
+
+    std::array<double, kMaxVenues> feeMult_{}; // feePct / 100 per venue
+    std::array<std::vector<OrderBook::PriceLevel>, kMaxVenues> bidScratch_; // Per venue book, reused
+    std::array<std::vector<OrderBook::PriceLevel>, kMaxVenues> askScratch_;
+    Snapshot staging_;                        // Built by rebuild(), then copied out
+
+    mutable std::atomic<uint64_t> seq_{0};   // Odd while published_ is being written
+    Snapshot published_;
+};
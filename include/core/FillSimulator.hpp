@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/OrderBook.hpp"
+#include "core/Types.hpp"
+
+#include <vector>
+
+// Result of matching a simulated order against book depth.
+struct SimulatedFill {
+    double qty      = 0.0;  // Filled base quantity (may be less than requested).
+    double avgPrice = 0.0;  // Volume-weighted average fill price.
+    int levels      = 0;    // Number of price levels touched.
+};
+
+// Matches simulated taker orders against an OrderBook's visible depth.
+// Liquidity taken at a level is remembered until the venue updates that level,
+// so back-to-back simulated orders do not fill against the same quantity twice.
+// Per-symbol state is sized on first use of a symbol; matching itself does not allocate.
+// Not thread-safe: owned and used by a single executor thread.
+class FillSimulator {
+public:
+    explicit FillSimulator(size_t depthLevels);
+
+    // Walks the opposite side of `book` from the best price until `qty` is filled,
+    // the next level is worse than `limitPrice`, or the visible depth runs out.
+    SimulatedFill match(SymbolId symbol, const OrderBook& book, Side side, double limitPrice, double qty);
+
+private:
+    struct Consumed {
+        double price    = 0.0;
+        double levelQty = 0.0;  // Level quantity when we consumed from it.
+        double taken    = 0.0;  // Quantity we have taken since.
+    };
+    using ConsumedLevels = std::vector<Consumed>; // Small, scanned linearly; capacity fixed at 2x depth
+
+    struct SymbolState {
+        ConsumedLevels bids;
+        ConsumedLevels asks;
+    };
+
+    // Drops consumption records for prices no longer in the visible depth.
+    void prune(ConsumedLevels& consumed) const;
+
+    size_t depthLevels_;
+    std::vector<OrderBook::PriceLevel> levels_; // Reused depth snapshot buffer
+    std::vector<SymbolState> states_;           // Indexed by SymbolId
+};
\ No newline at end of file
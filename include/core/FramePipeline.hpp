@@ -0,0 +1,109 @@
+#pragma once
+
+#include "common/LatencyHistogram.hpp"
+#include "common/RuntimeProfile.hpp"
+#include "core/SpscRing.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Moves raw websocket frames off socket threads: each socket pushes into its own
+// SPSC ring using pooled buffers, and book-builder threads parse and apply them.
+class FramePipeline {
+public:
+    // Runs on a builder thread for every frame of a channel. Frames queued while the
+    // builder was busy are delivered back to back as one batch; `last` marks the
+    // newest. A handler may stage or skip earlier frames but must leave the book
+    // committed once it returns from the last one, so the batch costs one version.
+    using Handler = std::function<void(std::string_view frame, int64_t recvNs, bool last)>;
+
+    // Runs on the builder thread after frames of a channel were dropped, once per run of
+    // drops, after the frames queued with them. Delta feeds must resynchronize here.
+    using GapHandler = std::function<void()>;
+
+    // One producer (socket thread) feeding one builder thread.
+    class Channel {
+    public:
+        // Socket thread: timestamps and copies the frame into a pooled buffer.
+        // Returns false (and counts a drop, flagging a gap) if no buffer or ring slot is free.
+        bool push(std::string_view frame);
+
+        const std::string& name() const { return name_; }
+
+    private:
+        friend class FramePipeline;
+
+        struct Frame {
+            int64_t recvNs = 0;
+            std::string data;
+        };
+
+        Channel(std::string name, Handler handler, GapHandler onGap, size_t depth, bool prefault);
+
+        std::string name_;
+        Handler handler_;
+        GapHandler onGap_;          // May be empty
+        std::unique_ptr<Frame[]> storage_;
+        SpscRing<Frame*> filled_;   // socket -> builder
+        SpscRing<Frame*> free_;     // builder -> socket
+        std::atomic<bool> closed_{false};
+        std::atomic<bool> gap_{false};  // Frames were dropped since the builder last checked
+        std::atomic<uint64_t> pushed_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<uint64_t> processed_{0};
+        std::atomic<uint64_t> conflated_{0};
+    };
+
+    struct Stats {
+        size_t channels = 0;
+        size_t depth = 0;           // Frames currently queued across channels
+        size_t maxDepth = 0;        // Deepest single channel right now
+        uint64_t pushed = 0;
+        uint64_t dropped = 0;
+        uint64_t processed = 0;
+        uint64_t conflated = 0;     // Frames folded into a later frame's book version
+    };
+
+    explicit FramePipeline(PipelineSettings settings);
+    ~FramePipeline();
+
+    // Registers a channel; frames pushed to it are handled on one builder thread.
+    // `onGap` (optional) is told when frames were dropped; snapshot feeds can omit it.
+    std::shared_ptr<Channel> addChannel(std::string name, Handler handler, GapHandler onGap = nullptr);
+
+    // Stops delivering frames for a channel. Its producer must have stopped pushing.
+    void removeChannel(const std::shared_ptr<Channel>& channel);
+
+    void start();
+    void stop();
+
+    // Totals across live channels (counters of removed channels are dropped).
+    Stats stats() const;
+
+private:
+    struct Builder {
+        std::thread thread;
+        std::mutex mutex;                               // Protects channels
+        std::vector<std::shared_ptr<Channel>> channels;
+        std::atomic<uint64_t> generation{0};            // Bumped when channels changes
+        LatencyHistogram queueLatency;                  // Socket receive -> applied; builder thread only
+        std::vector<Channel::Frame*> batch;             // Frames being handled; builder thread only
+    };
+
+    void run(size_t index);
+
+    // Logs pipeline counters and one builder's queue latency; called from that builder.
+    void logStats(size_t index, Builder& builder);
+
+    PipelineSettings settings_;
+    std::vector<std::unique_ptr<Builder>> builders_;
+    std::atomic<size_t> nextBuilder_{0};
+    std::atomic<bool> running_{false};
+};
@@ -1,32 +1,55 @@
 #pragma once
-#include <string>
+#include "core/Types.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
-// Trade fill report structure.
+// Order request handed to an executor. Trivially copyable; pooled by OrderPool.
+struct Order {
+    uint64_t id     = 0;            // Client order id (unique per process).
+    SymbolId symbol = 0;            // Interned trading symbol.
+    VenueId  venue  = 0;            // Interned exchange name.
+    Side     side   = Side::Buy;    // Trade side.
+    double   price  = 0.0;          // Reference/limit price.
+    double   qty    = 0.0;          // Maximum base-asset quantity to trade.
+    int64_t  ts     = 0;            // Send time (steady_clock ns); send-to-fill latency starts here.
+};
+
+// Trade fill report structure. Trivially copyable: no heap-owned members.
 struct Fill {
-    std::string exchange;   // Exchange name (e.g., "Binance Futures", "Bybit Futures").
-    std::string symbol;     // Trading symbol (e.g., "BTCUSDT").
-    std::string side;       // Trade side: "buy" or "sell".
+    uint64_t orderId = 0;           // Id of the order this fill reports on.
+    SymbolId symbol  = 0;           // Interned trading symbol (symbolTable().name()).
+    VenueId  venue   = 0;           // Interned exchange name (venueTable().name()).
+    Side     side    = Side::Buy;   // Trade side.
     double price = 0.0;     // Executed price.
     double qty   = 0.0;     // Executed base-asset quantity.
     double cost  = 0.0;     // Total cost in quote currency (e.g., USDT).
     double fee   = 0.0;     // Fee in quote currency.
     int64_t ts   = 0;       // Execution timestamp (epoch ms).
+    int64_t ackLatencyUs = 0; // Send-to-ack latency (simulated latency for paper fills).
     bool ok      = false;   // True if trade was successful.
+    bool pending = false;   // Accepted but not executed yet: the final fill comes from pollFills().
 };
 
+static_assert(std::is_trivially_copyable_v<Order>, "Order must stay trivially copyable");
+static_assert(std::is_trivially_copyable_v<Fill>, "Fill must stay trivially copyable");
+
 // Interface for trade execution on an exchange.
+// Implementations must not allocate in steady state.
 class ITradeExecutor {
 public:
     virtual ~ITradeExecutor() = default; // Ensure proper cleanup in derived classes.
 
-    // Execute a single trade and return a fill report.
-    // price: reference/limit price (PaperExecutor will execute at this; Live will use average).
-    // maxQty: maximum quantity to trade.
-    virtual Fill executeTrade(
-        const std::string& symbol,
-        const std::string& side,   // "buy" or "sell"
-        double price,
-        double maxQty
-    ) = 0;
-};
\ No newline at end of file
+    // Execute a single order and return a fill report.
+    // order.price: reference/limit price (PaperExecutor will execute at this; Live will use average).
+    // order.qty: maximum quantity to trade.
+    virtual Fill executeTrade(const Order& order) = 0;
+
+    // Final fills of orders whose executeTrade() reported Fill::pending, in completion
+    // order. Writes up to `max` fills to `out` and returns how many; never blocks.
+    virtual size_t pollFills(Fill* out, size_t max) {
+        (void)out;
+        (void)max;
+        return 0;
+    }
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "core/Types.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Maps names to dense integer ids. Interning is a cold-path operation (it may
+// allocate and takes a lock); name() is lock-free and safe from any thread.
+class Interner {
+public:
+    explicit Interner(size_t capacity);
+
+    // Returns the id for `name`, assigning the next free id on first sight.
+    // Throws std::length_error when the capacity is exhausted.
+    uint32_t intern(std::string_view name);
+
+    // Returns the id for `name`, or -1 if it was never interned.
+    int64_t find(std::string_view name) const;
+
+    // Returns the interned name for `id`. The reference stays valid for the process lifetime.
+    const std::string& name(uint32_t id) const { return names_[id]; }
+
+    // Number of interned names.
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+private:
+    size_t capacity_;
+    std::unique_ptr<std::string[]> names_;  // Fixed storage; entries are never moved
+    std::atomic<size_t> size_{0};
+    mutable std::mutex mutex_;              // Protects ids_ and appends to names_
+    std::unordered_map<std::string, uint32_t> ids_;
+};
+
+// Process-wide symbol table (capacity kMaxSymbols).
+Interner& symbolTable();
+
+// Process-wide venue table (capacity kMaxVenues).
+Interner& venueTable();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <mutex>
@@ -12,18 +14,36 @@ public:
     using PriceLevel = std::pair<double, double>;  // (price, quantity)
     using BookSide = std::map<double, double, std::greater<>>;  // price -> quantity, descending order for bids
 
+    // Best bid/ask read together under one lock.
+    struct TopOfBook {
+        double bid = 0.0, bidQty = 0.0;
+        double ask = 0.0, askQty = 0.0;
+        uint64_t version = 0;
+        int64_t updateNs = 0;   // steady_clock time of the last mutation
+    };
+
     // Update or remove a bid price level.
     void updateBid(double price, double quantity);
 
     // Update or remove an ask price level.
     void updateAsk(double price, double quantity);
 
+    // Applies a whole venue message under one lock and one version bump, so readers
+    // never see it half-applied. snapshot=true replaces the book; qty 0 removes a level.
+    void apply(const std::vector<PriceLevel>& bids, const std::vector<PriceLevel>& asks, bool snapshot);
+
     // Return top N bids (highest price first).
     std::vector<PriceLevel> getTopNBids(size_t n) const;
 
     // Return top N asks (lowest price first).
     std::vector<PriceLevel> getTopNAsks(size_t n) const;
 
+    // Copy top N bids into `out` (cleared first); reuses out's capacity.
+    void copyTopNBids(size_t n, std::vector<PriceLevel>& out) const;
+
+    // Copy top N asks into `out` (cleared first); reuses out's capacity.
+    void copyTopNAsks(size_t n, std::vector<PriceLevel>& out) const;
+
     // Get best (highest) bid price.
     double getTopBidPrice() const;
 
@@ -36,6 +56,12 @@ public:
     // Get quantity at best ask price.
     double getTopAskQty() const;   
 
+    // Consistent best bid/ask with the version they were read at.
+    TopOfBook getTop() const;
+
+    // Monotonic counter bumped on every mutation; cheap to poll for changes.
+    uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
     // Remove all bids and asks.
     void clear();
 
@@ -43,4 +69,9 @@ private:
     BookSide bids_;  // Bid side order book
     BookSide asks_;  // Ask side order book
     mutable std::mutex mutex_;  // Protects order book for thread safety
+    std::atomic<uint64_t> version_{0}; // Bumped under mutex_ on every mutation
+    int64_t updateNs_ = 0;             // steady_clock time of the last mutation (under mutex_)
+
+    // Records a mutation; call with mutex_ held.
+    void touch();
 };
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "core/ITradeExecutor.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Fixed-capacity pool of preallocated Order objects with sequential ids.
+// All storage is allocated in the constructor; acquire/release never allocate.
+// Not thread-safe: owned by the engine thread.
+class OrderPool {
+public:
+    explicit OrderPool(size_t capacity);
+
+    // Returns a reset order with a fresh id, or nullptr if the pool is exhausted.
+    Order* acquire();
+
+    // Returns an order to the pool.
+    void release(Order* order);
+
+    // Number of orders currently handed out.
+    size_t inUse() const { return orders_.size() - freeList_.size(); }
+
+private:
+    std::vector<Order> orders_;
+    std::vector<Order*> freeList_;
+    uint64_t nextId_ = 1;
+};
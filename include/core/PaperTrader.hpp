@@ -1,26 +1,72 @@
 #pragma once
 
 #include "core/ITradeExecutor.hpp"
+#include "core/FillSimulator.hpp"
+#include "core/SpscRing.hpp"
+#include "exchange/IExchangeClient.hpp"
+
+#include <atomic>
+#include <memory>
 #include <string>
+#include <thread>
+
+// Settings for depth- and latency-aware paper fills.
+struct PaperSimConfig {
+    bool enabled = false;         // false: fill maxQty at the reference price instantly.
+    double latencyMs = 0.0;       // Simulated order send-to-match latency.
+    size_t depthLevels = 20;      // Book levels visible to the simulator.
+    double slippagePct = 0.05;    // Worst fill price allowed vs reference, in percent.
+};
 
 // Simulates trade execution for paper trading.
 class PaperTrader : public ITradeExecutor {
 public:
     // exchangeName must match IExchangeClient::getExchangeName() for mapping.
     PaperTrader(std::string exchangeName, double feePercent);
+    ~PaperTrader() override;
+
+    // Fill against the venue's order book depth after the configured latency,
+    // consuming liquidity across calls. With a latency, orders are matched on a
+    // background thread when they arrive, and their fills come from pollFills().
+    void enableDepthSimulation(std::shared_ptr<IExchangeClient> venue, const PaperSimConfig& cfg);
 
-    // Simulate trade execution and return fill report.
-    Fill executeTrade(
-        const std::string& symbol,
-        const std::string& side,
-        double price,
-        double maxQty
-    ) override;
+    // Simulate trade execution and return fill report (pending while an order is in flight).
+    Fill executeTrade(const Order& order) override;
+
+    size_t pollFills(Fill* out, size_t max) override;
 
     // Returns the exchange name associated with this trader.
     const std::string& exchange() const { return exchange_; }
 
 private:
+    // An order on its way to the simulated venue.
+    struct InFlight {
+        Order order;
+        int64_t sentNs = 0;       // steady_clock time the engine sent it (Order::ts)
+        int64_t dueNs = 0;        // steady_clock time the order reaches the book
+    };
+
+    static constexpr size_t kMaxInFlight = 1024;
+
+    // Matches `order` against the book as it is now and completes `f`.
+    void match(const Order& order, Fill& f);
+
+    // Books the outcome of `f` (fee, cost, timestamp, ok) and logs it.
+    void finish(const Order& order, Fill& f);
+
+    // Matcher thread: waits for each order's arrival time, then matches it.
+    void runMatcher();
+
     std::string exchange_; // Exchange identifier
+    VenueId venue_;        // Interned exchange name
     double feePct_;        // Fee percent (e.g. 0.04 = 0.04%)
-};
\ No newline at end of file
+
+    PaperSimConfig sim_;                       // Depth simulation settings
+    std::shared_ptr<IExchangeClient> books_;   // Book source for depth simulation
+    std::unique_ptr<FillSimulator> simulator_; // Null unless depth simulation is enabled
+
+    SpscRing<InFlight> inFlight_{kMaxInFlight}; // Engine -> matcher
+    SpscRing<Fill> done_{kMaxInFlight};         // Matcher -> engine
+    std::atomic<bool> running_{false};
+    std::thread matcher_;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "common/ConfigManager.hpp"
+#include "core/OrderBook.hpp"
+#include "core/Types.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Decides when to unwind opposite inventory built up by arbitrage trades: sell on
+// the venue holding the largest long and buy on the venue holding the largest
+// short, once that reverse spread pays at least the rebalance threshold.
+// The venue pair is maintained incrementally when positions change (after fills),
+// so the per-tick decision is O(1) per symbol. Engine thread only.
+class RebalanceScheduler {
+public:
+    // An unwind to perform now; usd == 0 means none.
+    struct Plan {
+        size_t sellIdx = 0;     // Exchange index holding the long
+        size_t buyIdx = 0;      // Exchange index holding the short
+        double usd = 0.0;       // Notional to unwind on each leg
+        double spreadPct = 0.0; // (sell bid - buy ask) / buy ask
+    };
+
+    RebalanceScheduler();
+
+    void configure(const RebalanceSettings& settings) { settings_ = settings; }
+
+    // Records a symbol's positions (USD, signed, by exchange index) after they changed.
+    // O(venues); called on fills, not ticks.
+    void onPositions(SymbolId symbol, const double* usd, size_t venueCount);
+
+    // O(1): the unwind worth doing on these tops, if any. Unwinds smaller than
+    // minUnwindUsd wait to be batched with later inventory unless the position
+    // already leaves less than that much room under maxPosUsd.
+    Plan plan(SymbolId symbol, const OrderBook::TopOfBook* tops, const bool* valid,
+              double minSpreadPct, double maxPosUsd) const;
+
+private:
+    // Largest long and largest short of one symbol.
+    struct Inventory {
+        int longIdx = -1;       // -1: no long position
+        int shortIdx = -1;      // -1: no short position
+        double longUsd = 0.0;   // > 0
+        double shortUsd = 0.0;  // Size of the short, > 0
+    };
+
+    RebalanceSettings settings_;
+    std::vector<Inventory> inventory_; // Indexed by SymbolId
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "common/ConfigManager.hpp"
+#include "core/ITradeExecutor.hpp"
+#include "core/Types.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Why an order was refused by the risk gate.
+enum class RiskReject : uint8_t {
+    None,
+    KillSwitch,
+    RateLimit,
+    OrderNotional,
+    SymbolGross,
+    SymbolNet,
+    GlobalGross,
+    GlobalNet,
+    Duplicate,
+    SelfTrade,
+    Count
+};
+
+// Returns a short name for a reject reason (e.g. "rate_limit").
+const char* riskRejectName(RiskReject reason);
+
+// Pre-trade risk checks on the engine's decision path. Every check is O(1) per
+// order against counters preallocated in the constructor: no locks, no allocation.
+// Engine thread only.
+class RiskGate {
+public:
+    RiskGate();
+
+    // Applies limits; existing exposure, PnL and kill-switch state are kept.
+    // Venue rate overrides are matched by interned exchange name.
+    void configure(const RiskLimits& limits);
+
+    // Checks a group of orders meant to go out together (e.g. both legs of an
+    // arbitrage), using their combined effect on exposure. Consumes nothing.
+    RiskReject check(const Order* const* orders, size_t count, int64_t nowNs) const;
+
+    // Records orders that passed check() and are being sent: takes rate tokens
+    // and remembers them for the duplicate guard.
+    void onSend(const Order* const* orders, size_t count, int64_t nowNs);
+
+    // Applies an executed fill to exposure.
+    void onFill(const Fill& fill);
+
+    // Adds realized PnL; trips the kill switch once the loss limit is reached.
+    void onPnl(double pnlUsd);
+
+    // Counts a rejection (for stats).
+    void countReject(RiskReject reason) { ++rejects_[static_cast<size_t>(reason)]; }
+
+    bool killed() const { return killed_; }
+    double pnl() const { return pnlUsd_; }
+    double grossUsd() const { return grossUsd_; }
+    double netUsd() const { return netUsd_; }
+    uint64_t rejects(RiskReject reason) const { return rejects_[static_cast<size_t>(reason)]; }
+
+    // Re-arms trading after the kill switch tripped.
+    void resetKillSwitch() { killed_ = false; }
+
+private:
+    struct Bucket {
+        double ratePerNs = 0.0;    // 0 = unlimited
+        double capacity = 0.0;
+        mutable double tokens = 0.0;
+        mutable int64_t lastNs = 0;
+
+        // Refills to nowNs and returns the available tokens.
+        double available(int64_t nowNs) const;
+    };
+
+    struct LastOrder {
+        double price = 0.0;
+        double qty = 0.0;
+        int64_t sentNs = 0;
+    };
+
+    static size_t posIndex(VenueId venue, SymbolId symbol) { return static_cast<size_t>(symbol) * kMaxVenues + venue; }
+    static size_t lastIndex(const Order& o) { return posIndex(o.venue, o.symbol) * 2 + (o.side == Side::Buy ? 0 : 1); }
+    static double signedUsd(Side side, double usd) { return side == Side::Buy ? usd : -usd; }
+
+    RiskLimits limits_;
+    int64_t duplicateWindowNs_ = 0;
+
+    std::array<Bucket, kMaxVenues> buckets_{};
+    std::vector<double> positionUsd_;   // [symbol * kMaxVenues + venue], signed
+    std::vector<double> symbolGross_;   // Sum of |position| per symbol
+    std::vector<double> symbolNet_;     // Sum of positions per symbol
+    std::vector<LastOrder> lastOrder_;  // [posIndex * 2 + side]
+    double grossUsd_ = 0.0;
+    double netUsd_ = 0.0;
+    double pnlUsd_ = 0.0;
+    bool killed_ = false;
+    std::array<uint64_t, static_cast<size_t>(RiskReject::Count)> rejects_{};
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer publication of a small trivially copyable value. Readers copy it
+// out and retry if a write overlapped; neither side blocks the other.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock values are copied with memcpy");
+
+public:
+    // Writer thread only.
+    void store(const T& value) {
+        uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&value_), &value, sizeof(T));
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Any thread.
+    T load() const {
+        T out;
+        while (true) {
+            uint64_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1) continue; // Write in progress
+            std::memcpy(static_cast<void*>(&out), &value_, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) return out;
+        }
+    }
+
+private:
+    std::atomic<uint64_t> seq_{0}; // Odd while value_ is being written
+    T value_{};
+};
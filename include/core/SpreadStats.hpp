@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Streaming quantile estimator (P-square algorithm, Jain & Chlamtac 1985).
+// Keeps five markers; O(1) time and memory per observation.
+class P2Quantile {
+public:
+    explicit P2Quantile(double p);
+
+    void add(double x);
+
+    // Current estimate (exact while fewer than five samples were seen).
+    double value() const;
+
+private:
+    double p_;
+    double q_[5]{};    // Marker heights
+    double n_[5]{};    // Marker positions
+    double np_[5]{};   // Desired marker positions
+    double dn_[5]{};   // Desired position increments
+    size_t count_ = 0;
+};
+
+// Point-in-time copy of SpreadStats, safe to hand to other threads.
+struct SpreadStatsSnapshot {
+    uint64_t samples = 0;
+    double last = 0.0;               // Latest spread (%)
+    double ewma = 0.0;               // Exponentially weighted mean (%)
+    double stddev = 0.0;             // Exponentially weighted standard deviation (%)
+    double p50 = 0.0, p90 = 0.0, p99 = 0.0;
+    uint64_t opportunities = 0;      // Completed episodes above threshold
+    double avgOpportunityMs = 0.0;   // Mean episode duration
+    double maxOpportunityMs = 0.0;   // Longest episode
+    double openOpportunityMs = 0.0;  // Age of the episode in progress (0 if none)
+};
+
+// Rolling statistics of one cross-venue spread (buy on one venue, sell on another).
+// Every update is O(1) with no allocation. Not thread-safe: owned by the engine thread.
+class SpreadStats {
+public:
+    // alpha: EWMA weight of the newest sample.
+    explicit SpreadStats(double alpha = 0.05);
+
+    // Records a spread observation (%) at nowNs. An "opportunity" is a
+    // continuous run of observations above `threshold`.
+    void update(double spreadPct, double threshold, int64_t nowNs);
+
+    uint64_t samples() const { return samples_; }
+    double ewma() const { return ewma_; }
+    double variance() const { return variance_; }
+    double stddev() const;
+
+    SpreadStatsSnapshot snapshot(int64_t nowNs) const;
+
+private:
+    double alpha_;
+    uint64_t samples_ = 0;
+    double last_ = 0.0;
+    double ewma_ = 0.0;
+    double variance_ = 0.0;
+    P2Quantile p50_{0.50};
+    P2Quantile p90_{0.90};
+    P2Quantile p99_{0.99};
+
+    int64_t openSinceNs_ = 0;        // Start of the current opportunity, 0 if none
+    uint64_t opportunities_ = 0;
+    double totalOpportunityMs_ = 0.0;
+    double maxOpportunityMs_ = 0.0;
+};
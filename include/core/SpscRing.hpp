@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// Bounded lock-free single-producer/single-consumer ring. Capacity is rounded
+// up to a power of two. Storage is allocated once in the constructor.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : mask_(roundUp(capacity) - 1), slots_(std::make_unique<T[]>(mask_ + 1)) {}
+
+    // Producer side. Returns false if the ring is full.
+    bool tryPush(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ > mask_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ > mask_) return false;
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the ring is empty.
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) return false;
+        }
+        out = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate number of queued items; safe from any thread.
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static size_t roundUp(size_t n) {
+        size_t c = 2;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    static constexpr size_t kCacheLine = 64;
+
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+    alignas(kCacheLine) std::atomic<size_t> head_{0};  // Consumer position
+    size_t tailCache_ = 0;                             // Consumer's view of tail_
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};  // Producer position
+    size_t headCache_ = 0;                             // Producer's view of head_
+};
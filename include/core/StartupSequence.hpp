@@ -0,0 +1,45 @@
+#pragma once
+
+#include "exchange/IExchangeClient.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Times the startup phases from launch to trading and runs the steps shared by
+// every mode: parallel subscription and the book readiness barrier.
+class StartupSequence {
+public:
+    // Outcome of the readiness barrier.
+    struct Readiness {
+        size_t ready = 0;
+        size_t total = 0;
+        std::vector<std::string> missing; // "Venue:SYMBOL" of books still not two-sided
+    };
+
+    StartupSequence(); // Launch time is construction time
+
+    // Ends the current phase (started at the previous call, or at launch) and logs its duration.
+    void phase(const std::string& name);
+
+    // Logs every phase and the total time from launch.
+    void logSummary() const;
+
+    std::chrono::steady_clock::time_point launch() const { return launch_; }
+
+    // Subscribes every client to `symbols` on its own thread and returns once all have
+    // queued their sockets; sockets then connect in the background.
+    static void subscribeAll(const std::vector<std::shared_ptr<IExchangeClient>>& clients,
+                             const std::vector<std::string>& symbols);
+
+    // Waits until every (venue, symbol) book has a two-sided, uncrossed top, or the timeout passes.
+    static Readiness waitForBooks(const std::vector<std::shared_ptr<IExchangeClient>>& clients,
+                                  const std::vector<std::string>& symbols, double timeoutSec);
+
+private:
+    std::chrono::steady_clock::time_point launch_;
+    std::chrono::steady_clock::time_point phaseStart_;
+    std::vector<std::pair<std::string, double>> phases_; // Name, milliseconds
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+// Compact identifiers used on the trading hot path instead of strings.
+// Names are interned once (see core/Interner.hpp) and looked up only for logging.
+using SymbolId = uint16_t;  // Index into symbolTable()
+using VenueId  = uint8_t;   // Index into venueTable()
+
+constexpr SymbolId kMaxSymbols = 1024;
+constexpr VenueId  kMaxVenues  = 8;
+
+// Order side.
+enum class Side : uint8_t { Buy, Sell };
+
+// Returns "buy" or "sell".
+inline const char* sideName(Side side) { return side == Side::Buy ? "buy" : "sell"; }
@@ -1,44 +1,43 @@
 #pragma once
 
-#include "exchange/IExchangeClient.hpp"
-#include "core/OrderBook.hpp"
+#include "exchange/FeedHandler.hpp"
 
-#include <ixwebsocket/IXWebSocket.h>
-#include <unordered_map>
 #include <string>
-#include <mutex>
-#include <memory>
+#include <string_view>
+#include <vector>
+
+// Binance USDT futures partial-depth feed ("<symbol>@depth5@100ms"). A batch of
+// symbols shares one combined-stream socket, whose frames are wrapped as
+// {"stream": ..., "data": ...}.
+struct BinanceProtocol {
+    static constexpr const char* kName = "Binance Futures";
+    static constexpr const char* kTag = "Binance";
+    static constexpr size_t kMaxSymbolsPerSocket = 200; // Combined-stream limit
+    static constexpr std::string_view kRouteField = "stream";
+
+    // Frames are full snapshots, so only ordering needs tracking.
+    struct State {
+        uint64_t lastUpdateId = 0; // "u" of the last applied frame; older ones are dropped
+    };
+
+    // Depth stream name for a symbol.
+    static std::string routeKey(const std::string& symbol);
+
+    // Combined-stream URL; the streams are subscribed by the URL itself.
+    static std::string url(const std::vector<std::string>& keys);
+    static std::vector<std::string> subscribeRequests(const std::vector<std::string>&) { return {}; }
+    static std::string unsubscribeRequest(const std::string& key);
+
+    // Parses one depth message and applies it to the book. With last=false (a newer
+    // snapshot follows in the same batch) the frame is skipped unparsed. Never loses
+    // sync: every frame is a full book.
+    static bool decode(State& state, const std::string& key, OrderBook& ob, std::string_view frame, bool last);
+
+    // The next frame replaces the whole book, so a dropped one is harmless.
+    static bool onGap(State&, const std::string&, OrderBook&) { return true; }
+};
 
 // Binance USDT futures exchange client (WebSocket-based).
-class BinanceFuturesClient : public IExchangeClient {
-public:
-    BinanceFuturesClient();
-    ~BinanceFuturesClient() override;
+using BinanceFuturesClient = FeedHandler<BinanceProtocol>;
 
-    // Establish WebSocket connection(s) to Binance.
-    void connect() override;
-
-    // Disconnect all WebSocket connections.
-    void disconnect() override;
-
-    // Subscribe to order book updates for a symbol.
-    void subscribeOrderBook(const std::string& symbol) override;
-
-    // Get the current order book for a symbol.
-    std::shared_ptr<OrderBook> getOrderBook(const std::string& symbol) const override;
-
-    // Returns the exchange name ("binance_futures").
-    std::string getExchangeName() const override;
-
-private:
-    // Start a WebSocket connection for a symbol.
-    void startWebSocket(const std::string& symbol);
-
-    // Attempt to reconnect after a delay.
-    void reconnectWithDelay(const std::string& symbol);
-
-    mutable std::mutex mutex_; // Protects access to orderBooks_ and wsClients_
-    std::unordered_map<std::string, std::shared_ptr<OrderBook>> orderBooks_; // Symbol -> OrderBook
-    std::unordered_map<std::string, std::unique_ptr<ix::WebSocket>> wsClients_; // Symbol -> WebSocket client
-    bool connected_ = false; // Connection status
-};
\ No newline at end of file
+extern template class FeedHandler<BinanceProtocol>;
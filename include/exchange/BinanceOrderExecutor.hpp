@@ -0,0 +1,28 @@
+#pragma once
+
+#include "exchange/RestOrderExecutor.hpp"
+
+// Live order executor for Binance USDT-M futures (POST /fapi/v1/order, IOC limit orders).
+// Orders with an unknown outcome are reconciled with GET /fapi/v1/order?origClientOrderId=.
+class BinanceOrderExecutor : public RestOrderExecutor {
+public:
+    // exchangeName must match IExchangeClient::getExchangeName() for mapping.
+    BinanceOrderExecutor(std::string exchangeName, RestVenueConfig cfg);
+
+protected:
+    void buildTemplate(const std::string& symbol, SymbolTemplate& tmpl) override;
+    void buildOrderRequest(const SymbolTemplate& tmpl, const Order& order, double price,
+                           double qty, int64_t tsMs) override;
+    void parseAck(const HttpResponse& response, const Order& order, Fill& fill) override;
+    void buildQueryRequest(const Fill& fill, int64_t tsMs) override;
+    void parseQuery(const HttpResponse& response, Fill& fill, bool windowPassed) override;
+    std::string_view pingRequest() const override { return ping_; }
+
+private:
+    // Reads executedQty/avgPrice of an order reply into `fill` and sets fill.ok.
+    void parseExecution(std::string_view body, Fill& fill) const;
+
+    std::string headers_;   // Request line and constant headers, up to Content-Length
+    std::string queryHeaders_; // Everything after the query string of an order query
+    std::string ping_;
+};
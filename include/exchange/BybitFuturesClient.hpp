@@ -1,44 +1,45 @@
 #pragma once
 
-#include "exchange/IExchangeClient.hpp"
-#include "core/OrderBook.hpp"
+#include "exchange/FeedHandler.hpp"
 
-#include <ixwebsocket/IXWebSocket.h>
-#include <unordered_map>
 #include <string>
-#include <mutex>
-#include <memory>
+#include <string_view>
+#include <vector>
+
+// Bybit linear perpetual order book feed ("orderbook.50.<SYMBOL>"): a snapshot
+// followed by deltas. A batch of symbols shares one socket, subscribed on open.
+struct BybitProtocol {
+    static constexpr const char* kName = "Bybit Futures";
+    static constexpr const char* kTag = "Bybit";
+    static constexpr size_t kMaxSymbolsPerSocket = 500; // Keeps one connection's subscribe args within Bybit limits
+    static constexpr std::string_view kRouteField = "topic";
+
+    // Deltas only apply on top of a snapshot, each one's "u" following the previous by one.
+    struct State {
+        uint64_t lastUpdateId = 0; // "u" of the last accepted message
+        bool synced = false;       // A snapshot was seen since the stream started or last skipped an update
+    };
+
+    // Orderbook topic for a symbol.
+    static std::string routeKey(const std::string& symbol);
+
+    static std::string url(const std::vector<std::string>& keys);
+
+    // Subscribe requests for a socket's topics (Bybit takes at most 10 per request).
+    static std::vector<std::string> subscribeRequests(const std::vector<std::string>& keys);
+    static std::string unsubscribeRequest(const std::string& key);
+
+    // Parses one orderbook message for topic `key`. Levels are staged across frames
+    // and applied as one book update on the last frame of a batch. A delta that skips
+    // an update id clears the book and returns false; deltas are then ignored until
+    // the next snapshot.
+    static bool decode(State& state, const std::string& key, OrderBook& ob, std::string_view frame, bool last);
+
+    // A dropped delta is lost for good: clears the book like a sequence gap.
+    static bool onGap(State& state, const std::string& key, OrderBook& ob);
+};
 
 // Bybit USDT futures exchange client (WebSocket-based).
-class BybitFuturesClient : public IExchangeClient {
-public:
-    BybitFuturesClient();
-    ~BybitFuturesClient() override;
+using BybitFuturesClient = FeedHandler<BybitProtocol>;
 
-    // Establish WebSocket connection(s) to Bybit.
-    void connect() override;
-
-    // Disconnect all WebSocket connections.
-    void disconnect() override;
-
-    // Subscribe to order book updates for a symbol.
-    void subscribeOrderBook(const std::string& symbol) override;
-
-    // Get the current order book for a symbol.
-    std::shared_ptr<OrderBook> getOrderBook(const std::string& symbol) const override;
-
-    // Returns the exchange name ("bybit_futures").
-    std::string getExchangeName() const override;
-
-private:
-    // Start a WebSocket connection for a symbol.
-    void startWebSocket(const std::string& symbol);
-
-    // Attempt to reconnect after a delay.
-    void reconnectWithDelay(const std::string& symbol);
-
-    mutable std::mutex mutex_; // Protects access to orderBooks_ and wsClients_
-    std::unordered_map<std::string, std::shared_ptr<OrderBook>> orderBooks_; // Symbol -> OrderBook
-    std::unordered_map<std::string, std::unique_ptr<ix::WebSocket>> wsClients_; // Symbol -> WebSocket client
-    bool connected_ = false; // Connection status
-};
\ No newline at end of file
+extern template class FeedHandler<BybitProtocol>;
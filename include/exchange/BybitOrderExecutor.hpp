@@ -0,0 +1,29 @@
+#pragma once
+
+#include "exchange/RestOrderExecutor.hpp"
+
+// Live order executor for Bybit v5 linear perpetuals (POST /v5/order/create, IOC limit orders).
+// The create reply only accepts an order, so each fill comes from GET /v5/order/realtime.
+class BybitOrderExecutor : public RestOrderExecutor {
+public:
+    // exchangeName must match IExchangeClient::getExchangeName() for mapping.
+    BybitOrderExecutor(std::string exchangeName, RestVenueConfig cfg);
+
+protected:
+    void buildTemplate(const std::string& symbol, SymbolTemplate& tmpl) override;
+    void buildOrderRequest(const SymbolTemplate& tmpl, const Order& order, double price,
+                           double qty, int64_t tsMs) override;
+    void parseAck(const HttpResponse& response, const Order& order, Fill& fill) override;
+    void buildQueryRequest(const Fill& fill, int64_t tsMs) override;
+    void parseQuery(const HttpResponse& response, Fill& fill, bool windowPassed) override;
+    std::string_view pingRequest() const override { return ping_; }
+
+private:
+    // Signs timestamp + apiKey + recvWindow + payload into signature_; returns the timestamp text.
+    std::string_view sign(int64_t tsMs, std::string_view payload, char (&ts)[24]);
+
+    std::string headers_;       // Request line and constant headers
+    std::string queryHeaders_;  // Constant headers of an order query, after its request line
+    std::string recvWindow_;    // recvWindow as text (part of the signed payload)
+    std::string ping_;
+};
@@ -0,0 +1,450 @@
+#pragma once
+
+#include "exchange/IExchangeClient.hpp"
+#include "common/JsonScan.hpp"
+#include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+#include "core/FramePipeline.hpp"
+#include "core/Interner.hpp"
+#include "core/OrderBook.hpp"
+
+#include <ixwebsocket/IXWebSocket.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// WebSocket order book client for one venue, specialized at compile time by a
+// protocol policy. FeedHandler owns everything venue-independent: books, batched
+// sockets, reconnects, frame routing and the optional frame pipeline. The policy
+// only describes the venue:
+//
+//   struct Protocol {
+//       static constexpr const char* kName;             // getExchangeName()
+//       static constexpr const char* kTag;              // Short name for logs and pipeline channels
+//       static constexpr size_t kMaxSymbolsPerSocket;   // Cap for setSubscribeBatchSize()
+//       static constexpr std::string_view kRouteField;  // Field naming a data frame's stream
+//       struct State;                                   // Per-symbol decoder state (sequencing, staging)
+//       static std::string routeKey(const std::string& symbol);  // kRouteField value for a symbol
+//       static std::string url(const std::vector<std::string>& keys);
+//       static std::vector<std::string> subscribeRequests(const std::vector<std::string>& keys); // Sent on open
+//       static std::string unsubscribeRequest(const std::string& key);
+//       // Applies one frame; last=false means a newer frame of the same batch follows (see FramePipeline).
+//       // Returns false when the stream lost continuity: the decoder has cleared the book and
+//       // waits for a snapshot, which the handler requests by resubscribing the stream.
+//       static bool decode(State& state, const std::string& key, OrderBook& book, std::string_view frame, bool last);
+//       // Frames of the stream were dropped unseen (pipeline queue full); returns false like decode().
+//       static bool onGap(State& state, const std::string& key, OrderBook& book);
+//   };
+//
+// Routing and decoding are direct calls into the policy; nothing per frame is virtual.
+template <typename Protocol>
+class FeedHandler : public IExchangeClient {
+public:
+    FeedHandler() = default;
+    ~FeedHandler() override { disconnect(); }
+
+    // Enable subscriptions (sockets are opened per batch by subscribeOrderBooks()).
+    void connect() override;
+
+    // Disconnect all WebSocket connections.
+    void disconnect() override;
+
+    // Subscribe to order book updates for a symbol.
+    void subscribeOrderBook(const std::string& symbol) override { subscribeOrderBooks({ symbol }); }
+
+    // Subscribe to several symbols, up to the batch size per socket; sockets connect in parallel.
+    void subscribeOrderBooks(const std::vector<std::string>& symbols) override;
+
+    // Stop order book updates for a symbol and drop its book.
+    void unsubscribeOrderBook(const std::string& symbol) override;
+
+    // Hand raw frames to `pipeline` instead of parsing on the socket thread.
+    // Call before subscribing; symbols already subscribed keep parsing inline.
+    void setFramePipeline(std::shared_ptr<FramePipeline> pipeline);
+
+    // Symbols per socket, capped at Protocol::kMaxSymbolsPerSocket.
+    void setSubscribeBatchSize(size_t symbolsPerSocket);
+
+    // Get the current order book for a symbol.
+    std::shared_ptr<OrderBook> getOrderBook(const std::string& symbol) const override;
+
+    std::string getExchangeName() const override { return Protocol::kName; }
+
+private:
+    // Where frames of one stream go.
+    struct Route {
+        std::shared_ptr<OrderBook> book;
+        std::shared_ptr<FramePipeline::Channel> channel; // Null: decode inline
+        typename Protocol::State state;                  // Inline decoding only (the socket thread's)
+    };
+
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    // Route key -> route; the key set is fixed once a socket starts.
+    using Routes = std::unordered_map<std::string, Route, NameHash, std::equal_to<>>;
+
+    // One socket and the symbols it carries.
+    struct Stream {
+        std::unique_ptr<ix::WebSocket> ws;
+        std::vector<std::string> symbols;
+        bool reconnecting = false;  // A reconnect is pending (Error and Close both request one)
+    };
+
+    // Start (or restart) the socket of a stream batch.
+    void startStream(uint64_t streamId);
+
+    // Attempt to reconnect after a delay.
+    void reconnectWithDelay(uint64_t streamId);
+
+    // Unsubscribes and resubscribes one stream on its socket, so the venue sends a new snapshot.
+    void resync(const std::string& key);
+
+    // Reconnects and resyncs run on one owned worker thread, off the socket and builder
+    // threads, and are cancelled by disconnect() before `this` can go away.
+    struct Task {
+        std::chrono::steady_clock::time_point due;
+        std::function<void()> run;
+    };
+
+    // Queues `run` on the worker after `delay`; dropped once disconnect() has begun.
+    void post(std::chrono::milliseconds delay, std::function<void()> run);
+
+    // Worker loop: runs tasks as they fall due, without holding taskMutex_.
+    void runTasks();
+
+    // Drops queued tasks and joins the worker (waiting out a task that is running).
+    void stopWorker();
+
+    static constexpr std::chrono::milliseconds kReconnectDelay{ 3000 };
+
+    std::mutex taskMutex_; // Protects the task queue and worker handle
+    std::condition_variable taskCv_;
+    std::vector<Task> tasks_;
+    std::thread worker_;
+    bool stopping_ = false;
+
+    mutable std::mutex mutex_; // Protects everything below
+    std::unordered_map<std::string, std::shared_ptr<OrderBook>> orderBooks_; // Symbol -> OrderBook
+    std::unordered_map<uint64_t, Stream> streams_;                     // Stream id -> socket and symbols
+    std::unordered_map<std::string, uint64_t> symbolStream_;           // Symbol -> stream id
+    uint64_t nextStreamId_ = 1;
+    size_t batchSize_ = 50;
+    std::shared_ptr<FramePipeline> pipeline_; // Null: decode on the socket thread
+    std::unordered_map<std::string, std::shared_ptr<FramePipeline::Channel>> channels_; // Symbol -> pipeline channel
+    bool connected_ = false; // Connection status
+};
+
+template <typename Protocol>
+void FeedHandler<Protocol>::connect() {
+    if (connected_) {
+        Logger::info(std::string(Protocol::kName) + " client is already connected.");
+        return;
+    }
+
+    Logger::info("Connecting to " + std::string(Protocol::kName) + " WebSocket...");
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        stopping_ = false;
+    }
+    connected_ = true;
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::disconnect() {
+    // Pending reconnects and resyncs capture this: cancel them before anything else
+    stopWorker();
+    if (!connected_) return;
+
+    Logger::info("Disconnecting from " + std::string(Protocol::kName) + "...");
+
+    std::vector<std::unique_ptr<ix::WebSocket>> sockets;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [id, stream] : streams_) {
+            if (stream.ws) sockets.push_back(std::move(stream.ws));
+        }
+        streams_.clear();
+        symbolStream_.clear();
+        connected_ = false;
+    }
+    // stop() joins each socket's thread, so not under mutex_; Close callbacks posted meanwhile are dropped
+    for (auto& ws : sockets) ws->stop();
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::setFramePipeline(std::shared_ptr<FramePipeline> pipeline) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pipeline_ = std::move(pipeline);
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::setSubscribeBatchSize(size_t symbolsPerSocket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batchSize_ = std::clamp<size_t>(symbolsPerSocket, 1, Protocol::kMaxSymbolsPerSocket);
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::subscribeOrderBooks(const std::vector<std::string>& symbols) {
+    if (!connected_) {
+        Logger::error("Cannot subscribe: " + std::string(Protocol::kName) + " client is not connected.");
+        return;
+    }
+
+    std::vector<uint64_t> started;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stream* batch = nullptr;
+        for (const auto& symbol : symbols) {
+            if (symbolStream_.count(symbol)) continue; // Already subscribed
+
+            // Create order book if not already present
+            auto& ob = orderBooks_[symbol];
+            if (!ob) {
+                ob = std::make_shared<OrderBook>();
+                publishBook(static_cast<SymbolId>(symbolTable().intern(symbol)), ob.get());
+            }
+            // One channel per symbol, kept across reconnects (only one socket pushes at a time)
+            if (pipeline_ && channels_.find(symbol) == channels_.end()) {
+                // Both callbacks run on the channel's builder thread
+                auto state = std::make_shared<typename Protocol::State>();
+                std::string key = Protocol::routeKey(symbol);
+                channels_[symbol] = pipeline_->addChannel(std::string(Protocol::kTag) + ":" + symbol,
+                    [this, book = ob, key, state](std::string_view frame, int64_t, bool last) {
+                        if (!Protocol::decode(*state, key, *book, frame, last)) resync(key);
+                    },
+                    [this, book = ob, key, state]() {
+                        if (!Protocol::onGap(*state, key, *book)) resync(key);
+                    });
+            }
+
+            if (!batch || batch->symbols.size() >= batchSize_) {
+                started.push_back(nextStreamId_++);
+                batch = &streams_[started.back()];
+            }
+            batch->symbols.push_back(symbol);
+            symbolStream_[symbol] = started.back();
+        }
+    }
+
+    // ix::WebSocket::start() connects in the background, so batches come up in parallel.
+    for (uint64_t id : started) startStream(id);
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::unsubscribeOrderBook(const std::string& symbol) {
+    std::unique_ptr<ix::WebSocket> ws;
+    std::shared_ptr<FramePipeline::Channel> channel;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Dropping the book first stops any pending reconnect for this symbol
+        if (orderBooks_.erase(symbol)) publishBook(static_cast<SymbolId>(symbolTable().intern(symbol)), nullptr);
+        auto ch = channels_.find(symbol);
+        if (ch != channels_.end()) {
+            channel = std::move(ch->second);
+            channels_.erase(ch);
+        }
+
+        auto sit = symbolStream_.find(symbol);
+        if (sit != symbolStream_.end()) {
+            auto it = streams_.find(sit->second);
+            symbolStream_.erase(sit);
+            if (it != streams_.end()) {
+                auto& batch = it->second.symbols;
+                batch.erase(std::remove(batch.begin(), batch.end(), symbol), batch.end());
+                if (batch.empty()) {
+                    ws = std::move(it->second.ws);
+                    streams_.erase(it);
+                } else if (it->second.ws) {
+                    // Other symbols share the socket: drop just this stream
+                    it->second.ws->send(Protocol::unsubscribeRequest(Protocol::routeKey(symbol)));
+                }
+            }
+        }
+    }
+
+    Logger::info("Unsubscribing " + std::string(Protocol::kName) + " order book for: " + symbol);
+    if (ws) ws->stop();
+    if (channel) pipeline_->removeChannel(channel);
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::startStream(uint64_t streamId) {
+    auto routes = std::make_shared<Routes>();
+    std::vector<std::string> keys;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(streamId);
+        if (it == streams_.end()) return; // Every symbol was unsubscribed
+
+        for (const auto& symbol : it->second.symbols) {
+            auto ob = orderBooks_.find(symbol);
+            if (ob == orderBooks_.end()) continue;
+            auto ch = channels_.find(symbol);
+            std::string key = Protocol::routeKey(symbol);
+            keys.push_back(key);
+            routes->emplace(std::move(key), Route{ ob->second, ch != channels_.end() ? ch->second : nullptr, {} });
+        }
+    }
+    if (routes->empty()) return;
+
+    const std::string tag = Protocol::kTag;
+    Logger::info("Connecting to " + std::string(Protocol::kName) + " WebSocket for " +
+                 std::to_string(routes->size()) + " symbol(s)");
+
+    auto ws = std::make_unique<ix::WebSocket>();
+    ws->setUrl(Protocol::url(keys));
+
+    // Raw pointer is valid for the callback's lifetime: stop() joins before the socket is destroyed
+    ix::WebSocket* socket = ws.get();
+    auto requests = Protocol::subscribeRequests(keys);
+    ws->setOnMessageCallback([this, streamId, routes, requests, socket, tag](const ix::WebSocketMessagePtr& msg) {
+        RuntimeProfile::enterFeedThread();
+        if (msg->type == ix::WebSocketMessageType::Message) {
+            // Route on a leading field without a full parse (acks and pongs have none)
+            auto it = routes->find(jsonField(msg->str, Protocol::kRouteField));
+            if (it == routes->end()) return;
+            Route& route = it->second;
+            if (route.channel) route.channel->push(msg->str); // Book builder decodes it
+            else if (!Protocol::decode(route.state, it->first, *route.book, msg->str, true)) resync(it->first);
+        } else if (msg->type == ix::WebSocketMessageType::Open) {
+            Logger::info("WebSocket opened for " + std::to_string(routes->size()) + " " + tag + " stream(s)");
+            for (const auto& request : requests) socket->send(request);
+        } else if (msg->type == ix::WebSocketMessageType::Error) {
+            Logger::error(tag + " WebSocket error: " + msg->errorInfo.reason);
+            reconnectWithDelay(streamId);
+        } else if (msg->type == ix::WebSocketMessageType::Close) {
+            Logger::info(tag + " WebSocket closed for " + std::to_string(routes->size()) + " stream(s)");
+            reconnectWithDelay(streamId);
+        }
+    });
+
+    ws->start();
+
+    std::unique_ptr<ix::WebSocket> orphan;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(streamId);
+        if (it != streams_.end()) {
+            it->second.ws = std::move(ws);
+            it->second.reconnecting = false;
+        } else {
+            orphan = std::move(ws); // Unsubscribed while connecting
+        }
+    }
+    if (orphan) orphan->stop();
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::reconnectWithDelay(uint64_t streamId) {
+    // Runs on the worker, keeping the socket thread free (Error and Close both land here)
+    post(std::chrono::milliseconds(0), [this, streamId]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = streams_.find(streamId);
+            if (it == streams_.end() || it->second.reconnecting) return;
+            it->second.reconnecting = true;
+        }
+
+        Logger::info("Reconnecting " + std::string(Protocol::kTag) + " stream batch " + std::to_string(streamId) +
+                     " after 3 seconds...");
+        post(kReconnectDelay, [this, streamId]() {
+            std::unique_ptr<ix::WebSocket> old;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                // Every symbol was unsubscribed while waiting
+                auto it = streams_.find(streamId);
+                if (it == streams_.end()) return;
+                old = std::move(it->second.ws);
+            }
+
+            if (old) {
+                Logger::info("Stopping old WebSocket before reconnecting batch " + std::to_string(streamId));
+                old->stop();
+            }
+            startStream(streamId);
+        });
+    });
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::resync(const std::string& key) {
+    // On the worker like reconnects: socket callbacks and book builders must not wait on mutex_
+    post(std::chrono::milliseconds(0), [this, key]() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [id, stream] : streams_) {
+            if (!stream.ws || stream.reconnecting) continue;
+            for (const auto& symbol : stream.symbols) {
+                if (Protocol::routeKey(symbol) != key) continue;
+                Logger::warn(std::string(Protocol::kTag) + " " + symbol + " lost sync; resubscribing for a snapshot");
+                stream.ws->send(Protocol::unsubscribeRequest(key));
+                for (const auto& request : Protocol::subscribeRequests({ key })) stream.ws->send(request);
+                return;
+            }
+        }
+    });
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::post(std::chrono::milliseconds delay, std::function<void()> run) {
+    std::lock_guard<std::mutex> lock(taskMutex_);
+    if (stopping_) return;
+    tasks_.push_back(Task{ std::chrono::steady_clock::now() + delay, std::move(run) });
+    if (!worker_.joinable()) worker_ = std::thread(&FeedHandler::runTasks, this);
+    taskCv_.notify_one();
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::runTasks() {
+    std::unique_lock<std::mutex> lock(taskMutex_);
+    while (!stopping_) {
+        if (tasks_.empty()) {
+            taskCv_.wait(lock);
+            continue;
+        }
+        auto next = std::min_element(tasks_.begin(), tasks_.end(),
+                                     [](const Task& a, const Task& b) { return a.due < b.due; });
+        if (next->due > std::chrono::steady_clock::now()) {
+            taskCv_.wait_until(lock, next->due);
+            continue;
+        }
+        std::function<void()> run = std::move(next->run);
+        tasks_.erase(next);
+        lock.unlock(); // Tasks post follow-ups and stop sockets whose callbacks post
+        run();
+        lock.lock();
+    }
+}
+
+template <typename Protocol>
+void FeedHandler<Protocol>::stopWorker() {
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        stopping_ = true;
+        tasks_.clear();
+        worker = std::move(worker_);
+    }
+    taskCv_.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+template <typename Protocol>
+std::shared_ptr<OrderBook> FeedHandler<Protocol>::getOrderBook(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = orderBooks_.find(symbol);
+    if (it != orderBooks_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
 #include "core/OrderBook.hpp"
+#include "core/Types.hpp"
 
 // Interface for exchange clients.
 class IExchangeClient {
@@ -18,9 +22,29 @@ public:
     // Subscribe to order book updates for a symbol.
     virtual void subscribeOrderBook(const std::string& symbol) = 0;
 
+    // Subscribe to many symbols at once; clients may batch them onto shared connections.
+    virtual void subscribeOrderBooks(const std::vector<std::string>& symbols) {
+        for (const auto& symbol : symbols) subscribeOrderBook(symbol);
+    }
+
+    // Stop order book updates for a symbol and drop its book.
+    virtual void unsubscribeOrderBook(const std::string& symbol) = 0;
+
     // Get the current order book for a symbol.
     virtual std::shared_ptr<OrderBook> getOrderBook(const std::string& symbol) const = 0;
 
     // Returns the exchange name (e.g., "binance_futures").
     virtual std::string getExchangeName() const = 0;
+
+    // Lock-free and non-virtual, for scan loops: identifies the book currently behind
+    // getOrderBook() for `symbol` (null if none). Compare it only; dereference the
+    // shared_ptr from getOrderBook(), which keeps the book alive.
+    const OrderBook* currentBook(SymbolId symbol) const { return books_[symbol].load(std::memory_order_acquire); }
+
+protected:
+    // Implementations call this whenever the book returned for `symbol` changes.
+    void publishBook(SymbolId symbol, const OrderBook* book) { books_[symbol].store(book, std::memory_order_release); }
+
+private:
+    std::array<std::atomic<const OrderBook*>, kMaxSymbols> books_{};
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "common/ConfigManager.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Trading rules of one contract.
+struct Instrument {
+    std::string symbol;
+    double tickSize = 0.0;  // Price increment
+    double lotSize = 0.0;   // Quantity increment
+};
+
+// Perpetuals tradable on both venues, with each venue's increments.
+struct Universe {
+    std::vector<std::string> symbols;                       // Sorted
+    std::unordered_map<std::string, Instrument> binance;    // Symbol -> rules
+    std::unordered_map<std::string, Instrument> bybit;
+};
+
+// Discovers the tradable universe from venue instrument metadata: Binance
+// /fapi/v1/exchangeInfo and Bybit /v5/market/instruments-info (linear), fetched
+// over REST or read from local fixture files.
+class InstrumentCatalog {
+public:
+    // Intersection of `quote`-margined perpetuals trading on both venues.
+    // Throws std::runtime_error if either venue's metadata cannot be loaded.
+    static Universe discover(const UniverseSettings& settings, const std::string& binanceRestUrl,
+                             const std::string& bybitRestUrl);
+
+    // Parses an exchangeInfo document: PERPETUAL contracts in status TRADING.
+    static std::vector<Instrument> parseBinance(std::string_view json, const std::string& quote);
+
+    // Parses one instruments-info page: LinearPerpetual contracts in status Trading.
+    // Sets `nextCursor` to the page cursor (empty on the last page).
+    static std::vector<Instrument> parseBybit(std::string_view json, const std::string& quote, std::string& nextCursor);
+
+private:
+    static std::vector<Instrument> loadBinance(const UniverseSettings& settings, const std::string& restUrl);
+    static std::vector<Instrument> loadBybit(const UniverseSettings& settings, const std::string& restUrl);
+};
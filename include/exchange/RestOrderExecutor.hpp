@@ -0,0 +1,153 @@
+#pragma once
+
+#include "common/HmacSha256.hpp"
+#include "core/ITradeExecutor.hpp"
+#include "net/HttpConnection.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Credentials and endpoint for a live order executor.
+struct RestVenueConfig {
+    std::string apiKey;
+    std::string secret;
+    std::string restUrl;            // e.g. "https://fapi.binance.com" or "http://127.0.0.1:9000" for a stub venue
+    double takerFeePct = 0.04;      // Used to estimate Fill::fee (percent of notional)
+    int recvWindowMs = 5000;
+    double keepAliveSec = 30.0;     // Idle time after which the connection is pinged (0 = never)
+    int timeoutMs = 2000;           // Connect and request limit; a timed-out order is reconciled by query
+};
+
+// Base class for live REST order executors. It owns one persistent keep-alive
+// connection (warmed up before trading starts), a keyed HMAC-SHA256 context and
+// per-symbol order templates, so sending an order only formats qty, price and
+// timestamp into preallocated buffers. Reports send-to-ack latency in Fill::ackLatencyUs.
+// Where the order reply is only an acknowledgement, the execution is queried before
+// the fill is reported; one still working is reported later through pollFills().
+// An order whose fate is unknown (no reply, or a venue error that does not say) is
+// reported pending too and reconciled by its client order id the same way.
+class RestOrderExecutor : public ITradeExecutor {
+public:
+    ~RestOrderExecutor() override;
+
+    // Pre-serializes the order templates for a symbol. tickSize/lotSize round
+    // price (to nearest) and qty (down); 0 leaves values unrounded.
+    void prepareSymbol(const std::string& symbol, double tickSize = 0.0, double lotSize = 0.0);
+
+    // Opens the connection, completes the TLS handshake with a cheap request and
+    // starts the keep-alive thread. Returns false if the venue is unreachable.
+    bool warmUp();
+
+    Fill executeTrade(const Order& order) override;
+
+    // Re-queries unconfirmed orders (one round trip each, at most every kQueryIntervalMs)
+    // and returns those that reached a final state. One still unresolved after
+    // kConfirmTimeoutSec is logged and queried every kSlowQueryIntervalMs from then on;
+    // it is never reported unfilled without the venue saying so.
+    size_t pollFills(Fill* out, size_t max) override;
+
+    const std::string& exchange() const { return exchange_; }
+
+    static constexpr int kQueryIntervalMs = 50;
+    static constexpr int kSlowQueryIntervalMs = 1000;
+    static constexpr int kConfirmTimeoutSec = 10;
+
+protected:
+    // Pre-serialized pieces of an order request for one symbol.
+    struct SymbolTemplate {
+        bool ready = false;
+        std::string prefix[2];      // Indexed by Side: everything up to the quantity value
+        double tickSize = 0.0;
+        double lotSize = 0.0;
+        int priceDecimals = 8;
+        int qtyDecimals = 8;
+    };
+
+    RestOrderExecutor(std::string exchangeName, RestVenueConfig cfg);
+
+    // Builds the symbol/side-specific template prefixes.
+    virtual void buildTemplate(const std::string& symbol, SymbolTemplate& tmpl) = 0;
+
+    // Serializes a complete HTTP request for `order` into request_ (using body_ as scratch).
+    virtual void buildOrderRequest(const SymbolTemplate& tmpl, const Order& order, double price,
+                                   double qty, int64_t tsMs) = 0;
+
+    // Fills execution fields of `fill` from the venue's reply and sets fill.ok.
+    // On entry fill.qty/price hold the rounded values that were sent. Sets fill.pending
+    // instead if the reply only accepts the order, or leaves its fate unknown (e.g. a 5xx);
+    // the execution is then queried.
+    virtual void parseAck(const HttpResponse& response, const Order& order, Fill& fill) = 0;
+
+    // Serializes a request for the execution state of the order behind `fill`, looked up
+    // by its client order id, into request_.
+    virtual void buildQueryRequest(const Fill& fill, int64_t tsMs) = 0;
+
+    // Fills execution fields of `fill` from a query reply and clears fill.pending once the
+    // order is final; leaves it set while the venue is still working the order or the reply
+    // is inconclusive. `windowPassed` is true once the order's recvWindow has elapsed since
+    // it was sent: a venue with no record of the order then never had it (not filled).
+    virtual void parseQuery(const HttpResponse& response, Fill& fill, bool windowPassed) = 0;
+
+    // A cheap unauthenticated request used to warm up and keep the connection alive.
+    virtual std::string_view pingRequest() const = 0;
+
+    // Appends `value` with a fixed number of decimals (no allocation).
+    static void appendDecimal(std::string& out, double value, int decimals);
+
+    // Appends an unsigned integer (no allocation).
+    static void appendInt(std::string& out, uint64_t value);
+
+    // Returns the raw value of "key": in a flat JSON object (quotes stripped), or empty.
+    static std::string_view jsonField(std::string_view body, std::string_view key);
+
+    std::string exchange_;
+    VenueId venue_;
+    RestVenueConfig cfg_;
+    std::string orderIdPrefix_;     // Unique per process run, prepended to client order ids
+    HmacSha256 signer_;
+    HttpConnection conn_;
+    std::string body_;              // Request body scratch buffer
+    std::string request_;           // Full request scratch buffer
+    char signature_[HmacSha256::kHexSize];
+
+private:
+    // An accepted order whose execution the venue has not reported final yet.
+    struct Unconfirmed {
+        bool active = false;
+        Fill fill;                                      // As sent, pending
+        std::chrono::steady_clock::time_point sent;
+        std::chrono::steady_clock::time_point nextQuery;
+        bool overdue = false;                           // Logged as unresolved after kConfirmTimeoutSec
+    };
+
+    static constexpr size_t kMaxUnconfirmed = 32;
+
+    void keepAliveLoop();
+
+    // Queries the execution of a pending fill sent at `sent` (under mutex_); it stays
+    // pending on failure.
+    void queryFill(Fill& fill, std::chrono::steady_clock::time_point sent);
+
+    // Parks a pending fill for pollFills() and returns what executeTrade() reports now.
+    Fill awaitExecution(Fill& fill, std::chrono::steady_clock::time_point sent);
+
+    // Sets the cost of a final fill and logs it.
+    void reportFill(Fill& fill);
+
+    std::mutex mutex_;              // Serializes use of the connection and buffers
+    std::vector<SymbolTemplate> templates_;   // Indexed by SymbolId
+    std::array<Unconfirmed, kMaxUnconfirmed> unconfirmed_{};
+    size_t unconfirmedCount_ = 0;
+    std::chrono::steady_clock::time_point lastUse_;
+    std::atomic<bool> running_{false};
+    std::mutex stopMutex_;          // For stopCv_ only, so waiting never holds mutex_
+    std::condition_variable stopCv_;
+    std::thread keepAlive_;
+};
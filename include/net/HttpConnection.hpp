@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_st SSL;
+
+// Parsed HTTP response. `body` points into the connection's buffer and is
+// valid until the next request on that connection.
+struct HttpResponse {
+    int status = 0;
+    std::string_view body;
+};
+
+// Endpoint parsed from a URL such as "https://fapi.binance.com" or "http://127.0.0.1:8080".
+struct HttpEndpoint {
+    std::string host;
+    uint16_t port = 443;
+    bool tls = true;
+
+    // Parses scheme, host and optional port. Throws std::invalid_argument on malformed input.
+    static HttpEndpoint parse(const std::string& url);
+};
+
+// Persistent HTTP/1.1 keep-alive connection over TCP, with TLS unless the
+// endpoint is plain http (e.g. a local stub venue). Buffers are allocated once;
+// a round trip on an open connection does not allocate. Connecting and each round
+// trip fail after `timeoutMs` (0 = wait forever). Not thread-safe.
+class HttpConnection {
+public:
+    explicit HttpConnection(HttpEndpoint endpoint, int timeoutMs = 5000);
+    ~HttpConnection();
+
+    HttpConnection(const HttpConnection&) = delete;
+    HttpConnection& operator=(const HttpConnection&) = delete;
+
+    // Resolves, connects (TCP_NODELAY) and completes the TLS handshake within the timeout.
+    bool connect();
+
+    // Closes the connection.
+    void close();
+
+    bool isOpen() const { return fd_ >= 0; }
+
+    // Sends a complete serialized request and reads one response.
+    // Reconnects first if the peer closed the idle connection. On a failure
+    // after the request was written the connection is closed and false returned;
+    // the request is never resent, since the venue may already have acted on it.
+    // A response not complete within the timeout counts as such a failure.
+    bool roundTrip(std::string_view request, HttpResponse& response);
+
+    const HttpEndpoint& endpoint() const { return endpoint_; }
+
+private:
+    bool writeAll(const char* data, size_t len);
+    long readSome(char* data, size_t len);
+
+    // Waits until the socket has data to read or deadline_ passes.
+    bool waitReadable();
+
+    // True if the peer has closed the connection while it sat idle.
+    bool peerClosed() const;
+
+    // Reads a full response (Content-Length or chunked) into buf_/body_.
+    bool readResponse(HttpResponse& response);
+
+    HttpEndpoint endpoint_;
+    std::chrono::milliseconds timeout_;
+    std::chrono::steady_clock::time_point deadline_; // Of the round trip in progress
+    int fd_ = -1;
+    SSL_CTX* sslCtx_ = nullptr;
+    SSL* ssl_ = nullptr;
+    std::vector<char> buf_;  // Raw receive buffer
+    std::string body_;       // De-chunked body (reserved once)
+};
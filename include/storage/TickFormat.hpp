@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// On-disk format of the tick store (see TickStore and tools/tickq.cpp).
+//
+// A file holds one table (top-of-book or spread rows) for one symbol and one UTC
+// day, as a sequence of self-contained chunks. Each chunk is a ChunkHeader
+// followed by a payload, optionally zlib-compressed, that stores:
+//   venue names: u8 count, then (u8 length, bytes) per venue
+//   each column: u32 byte length, then one zigzag varint per row holding the
+//                delta from the previous row's value (the first from 0)
+// Values are fixed-point integers (see the scales below). Little-endian only.
+namespace tickfmt {
+
+enum class Table : uint8_t { Bbo = 0, Spread = 1 };
+
+// Top-of-book columns: time, venue index, bid, bid qty, ask, ask qty.
+constexpr size_t kBboTs = 0, kBboVenue = 1, kBboBid = 2, kBboBidQty = 3, kBboAsk = 4, kBboAskQty = 5;
+constexpr size_t kBboColumns = 6;
+
+// Spread columns: time, buy venue index, sell venue index, spread (percent).
+constexpr size_t kSpreadTs = 0, kSpreadBuy = 1, kSpreadSell = 2, kSpreadPct = 3;
+constexpr size_t kSpreadColumns = 4;
+
+constexpr size_t kMaxColumns = kBboColumns;
+constexpr double kPriceScale = 1e8;   // Prices and quantities
+constexpr double kSpreadScale = 1e6;  // Spread percent
+
+constexpr uint32_t kChunkMagic = 0x4B435354; // "TSCK"
+
+struct ChunkHeader {
+    uint32_t magic = kChunkMagic;
+    uint32_t rows = 0;
+    int64_t minTsUs = 0;     // Epoch microseconds (UTC)
+    int64_t maxTsUs = 0;
+    uint8_t table = 0;       // Table
+    uint8_t columns = 0;
+    uint8_t compressed = 0;  // 1 = payload is zlib-compressed
+    uint8_t reserved = 0;
+    uint32_t rawSize = 0;    // Payload size before compression
+    uint32_t payloadSize = 0;
+};
+static_assert(sizeof(ChunkHeader) == 40, "ChunkHeader is written as-is");
+
+using Columns = std::array<std::vector<int64_t>, kMaxColumns>;
+
+inline size_t columnCount(Table table) { return table == Table::Bbo ? kBboColumns : kSpreadColumns; }
+
+inline int64_t toFixed(double value, double scale) { return static_cast<int64_t>(value * scale + (value >= 0 ? 0.5 : -0.5)); }
+
+// Appends one encoded chunk of `rows` rows to `out`. `scratch` is reused between calls.
+void encodeChunk(Table table, const Columns& columns, size_t rows, const std::vector<std::string>& venues,
+                 bool compress, std::string& out, std::string& scratch);
+
+// A chunk located in a mapped file; payload points into the mapping.
+struct ChunkView {
+    ChunkHeader header;
+    const uint8_t* payload = nullptr;
+};
+
+// Walks the chunks of a file image.
+class ChunkReader {
+public:
+    ChunkReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    // Advances to the next chunk. Returns false at the end or on a truncated/corrupt chunk.
+    bool next(ChunkView& chunk);
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+// Decodes a chunk into columns (resized to the row count) and venue names.
+// `scratch` receives the inflated payload of compressed chunks. Returns false on corrupt data.
+bool decodeChunk(const ChunkView& chunk, Columns& columns, std::vector<std::string>& venues, std::string& scratch);
+
+} // namespace tickfmt
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "common/ConfigManager.hpp"
+#include "core/SpscRing.hpp"
+#include "core/Types.hpp"
+#include "storage/TickFormat.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Records top-of-book and spread history to disk for offline analysis.
+// The engine thread queues fixed-size rows into an SPSC ring; a background
+// writer buffers them per symbol and table, and appends delta/varint encoded
+// chunks (see TickFormat.hpp) to <dir>/<YYYYMMDD>/<SYMBOL>.<bbo|spread>.tks.
+class TickStore {
+public:
+    explicit TickStore(TickStoreSettings settings);
+    ~TickStore();
+
+    // Allocates and touches the write buffers of `symbols` now rather than on their
+    // first rows. Call before start(); later calls are ignored.
+    void prepare(const std::vector<SymbolId>& symbols);
+
+    void start();
+    void stop(); // Drains the queue and writes every buffered row.
+
+    // Producer side (one thread, normally the engine). Never blocks or allocates;
+    // the row is dropped and counted when the writer has fallen behind.
+    void recordTop(SymbolId symbol, VenueId venue, double bid, double bidQty, double ask, double askQty);
+    void recordSpread(SymbolId symbol, VenueId buyVenue, VenueId sellVenue, double spreadPct);
+
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Row {
+        int64_t tsUs = 0;
+        SymbolId symbol = 0;
+        tickfmt::Table table = tickfmt::Table::Bbo;
+        VenueId a = 0;
+        VenueId b = 0;
+        double v[4] = {};
+    };
+
+    // Rows buffered for one (symbol, table) file.
+    struct Buffer {
+        tickfmt::Columns columns;
+        size_t rows = 0;
+        int64_t day = -1; // UTC day (days since epoch) of the buffered rows
+    };
+
+    void push(const Row& row);
+    void run();
+    void append(const Row& row);
+    void flush(SymbolId symbol, tickfmt::Table table, Buffer& buf);
+    void flushAll();
+    std::string pathFor(SymbolId symbol, tickfmt::Table table, int64_t day) const;
+
+    TickStoreSettings settings_;
+    SpscRing<Row> queue_;
+    std::vector<Buffer> buffers_; // Indexed [symbol * 2 + table]; writer thread only
+    std::string chunk_;           // Encoding buffers, reused
+    std::string scratch_;
+    std::vector<std::string> venues_;
+
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
@@ -1,19 +1,24 @@
 #include "common/ConfigManager.hpp"
+#include "common/Logger.hpp"
+#include "core/Interner.hpp"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <stdexcept>
 
-// Static member definitions (default values)
-std::vector<std::string> ConfigManager::symbols_;
-std::string ConfigManager::mode_ = "paper";
-double ConfigManager::feesPercent_ = 0.04;
-double ConfigManager::maxPosUsd_ = 1000.0;
-double ConfigManager::minSpreadPercent_ = 0.05;
-double ConfigManager::rebalanceMinSpread_ = 0.02;
-double ConfigManager::checkIntervalSeconds_ = 1;
+namespace {
+    // Default values, published until the first load().
+    const ConfigSnapshot kDefaults{};
+}
 
-// Load configuration from JSON file.
-void ConfigManager::load(const std::string& filePath) {
+// Static member definitions
+std::atomic<const ConfigSnapshot*> ConfigManager::current_{&kDefaults};
+std::vector<std::unique_ptr<const ConfigSnapshot>> ConfigManager::published_;
+std::mutex ConfigManager::publishMutex_;
+std::string ConfigManager::filePath_ = "config.json";
+std::vector<std::string> ConfigManager::symbolOverride_;
+
+// Parse configuration from JSON file.
+ConfigSnapshot ConfigManager::parse(const std::string& filePath) {
     std::ifstream file(filePath);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open config file: " + filePath);
@@ -22,63 +27,267 @@ void ConfigManager::load(const std::string& filePath) {
     nlohmann::json config;
     file >> config;
 
-    symbols_.clear();
+    ConfigSnapshot cfg;
+
     if (config.contains("symbols")) {
         for (const auto& sym : config["symbols"]) {
-            symbols_.emplace_back(sym.get<std::string>());
+            cfg.symbols.emplace_back(sym.get<std::string>());
+        }
+        if (cfg.symbols.size() > kMaxSymbols) {
+            throw std::runtime_error(std::to_string(cfg.symbols.size()) + " symbols configured, at most " +
+                                     std::to_string(kMaxSymbols) + " are supported");
         }
     }
 
     if (config.contains("mode")) {
-        mode_ = config["mode"].get<std::string>();
+        cfg.mode = config["mode"].get<std::string>();
     }
 
     if (config.contains("fees")) {
-        feesPercent_ = config["fees"].get<double>();
+        cfg.feesPercent = config["fees"].get<double>();
     }
 
     if (config.contains("maxPosUsd")) {
-        maxPosUsd_ = config["maxPosUsd"].get<double>();
+        cfg.maxPosUsd = config["maxPosUsd"].get<double>();
     }
 
     if (config.contains("minSpreadPercent")) {
-        minSpreadPercent_ = config["minSpreadPercent"].get<double>();
+        cfg.minSpreadPercent = config["minSpreadPercent"].get<double>();
     }
 
     if (config.contains("rebalanceMinSpread")) {
-        rebalanceMinSpread_ = config["rebalanceMinSpread"].get<double>();
+        cfg.rebalanceMinSpread = config["rebalanceMinSpread"].get<double>();
     }
 
     if (config.contains("checkIntervalSec")) {
-        checkIntervalSeconds_ = config["checkIntervalSec"].get<double>();
+        cfg.checkIntervalSeconds = config["checkIntervalSec"].get<double>();
+    }
+
+    if (config.contains("paperSim")) {
+        const auto& sim = config["paperSim"];
+        cfg.paperSimEnabled = sim.value("enabled", cfg.paperSimEnabled);
+        cfg.paperLatencyMs = sim.value("latencyMs", cfg.paperLatencyMs);
+        cfg.paperDepthLevels = sim.value("depthLevels", cfg.paperDepthLevels);
+        cfg.paperSlippagePct = sim.value("slippagePct", cfg.paperSlippagePct);
+    }
+
+    if (config.contains("adaptiveThreshold")) {
+        const auto& adaptive = config["adaptiveThreshold"];
+        cfg.adaptiveThreshold = adaptive.value("enabled", cfg.adaptiveThreshold);
+        cfg.adaptiveStddevMult = adaptive.value("stddevMultiplier", cfg.adaptiveStddevMult);
+        cfg.adaptiveMinSamples = adaptive.value("minSamples", cfg.adaptiveMinSamples);
+    }
+
+    if (config.contains("statsLogIntervalSec")) {
+        cfg.statsLogIntervalSec = config["statsLogIntervalSec"].get<double>();
+    }
+
+    auto parseVenue = [&config](const char* name, VenueCredentials& venue) {
+        if (!config.contains(name)) return;
+        const auto& v = config[name];
+        venue.apiKey = v.value("api_key", venue.apiKey);
+        venue.secret = v.value("secret", venue.secret);
+        venue.restUrl = v.value("rest_url", venue.restUrl);
+    };
+    parseVenue("binance", cfg.binance);
+    parseVenue("bybit", cfg.bybit);
+
+    if (config.contains("live")) {
+        const auto& live = config["live"];
+        cfg.liveRecvWindowMs = live.value("recvWindowMs", cfg.liveRecvWindowMs);
+        cfg.liveKeepAliveSec = live.value("keepAliveSec", cfg.liveKeepAliveSec);
+        cfg.liveTimeoutMs = live.value("timeoutMs", cfg.liveTimeoutMs);
+    }
+
+    if (config.contains("runtime")) {
+        const auto& rt = config["runtime"];
+        cfg.runtime.feedCores = rt.value("feedCores", cfg.runtime.feedCores);
+        cfg.runtime.engineCore = rt.value("engineCore", cfg.runtime.engineCore);
+        cfg.runtime.busyPoll = rt.value("busyPoll", cfg.runtime.busyPoll);
+        cfg.runtime.pauseBackoff = rt.value("pauseBackoff", cfg.runtime.pauseBackoff);
+        cfg.runtime.lockMemory = rt.value("lockMemory", cfg.runtime.lockMemory);
+        cfg.runtime.numaLocal = rt.value("numaLocal", cfg.runtime.numaLocal);
+    }
+
+    if (config.contains("risk")) {
+        const auto& risk = config["risk"];
+        auto parseRate = [](const nlohmann::json& j, RateLimit& rate) {
+            rate.ordersPerSec = j.value("ordersPerSec", rate.ordersPerSec);
+            rate.burst = j.value("burst", rate.burst);
+        };
+        cfg.risk.maxOrderUsd = risk.value("maxOrderUsd", cfg.risk.maxOrderUsd);
+        cfg.risk.maxSymbolGrossUsd = risk.value("maxSymbolGrossUsd", cfg.risk.maxSymbolGrossUsd);
+        cfg.risk.maxSymbolNetUsd = risk.value("maxSymbolNetUsd", cfg.risk.maxSymbolNetUsd);
+        cfg.risk.maxGrossUsd = risk.value("maxGrossUsd", cfg.risk.maxGrossUsd);
+        cfg.risk.maxNetUsd = risk.value("maxNetUsd", cfg.risk.maxNetUsd);
+        cfg.risk.maxLossUsd = risk.value("maxLossUsd", cfg.risk.maxLossUsd);
+        cfg.risk.duplicateWindowMs = risk.value("duplicateWindowMs", cfg.risk.duplicateWindowMs);
+        parseRate(risk, cfg.risk.rate);
+        if (risk.contains("venues")) {
+            for (const auto& [name, limits] : risk["venues"].items()) {
+                RateLimit rate = cfg.risk.rate;
+                parseRate(limits, rate);
+                cfg.risk.venueRates[name] = rate;
+            }
+        }
+    }
+
+    if (config.contains("rebalance")) {
+        const auto& rb = config["rebalance"];
+        cfg.rebalance.minUnwindUsd = rb.value("minUnwindUsd", cfg.rebalance.minUnwindUsd);
+        cfg.rebalance.maxUnwindUsd = rb.value("maxUnwindUsd", cfg.rebalance.maxUnwindUsd);
+    }
+
+    if (config.contains("universe")) {
+        const auto& u = config["universe"];
+        cfg.universe.enabled = u.value("enabled", cfg.universe.enabled);
+        cfg.universe.quote = u.value("quote", cfg.universe.quote);
+        cfg.universe.maxSymbols = u.value("maxSymbols", cfg.universe.maxSymbols);
+        cfg.universe.binanceFixture = u.value("binanceFixture", cfg.universe.binanceFixture);
+        cfg.universe.bybitFixture = u.value("bybitFixture", cfg.universe.bybitFixture);
+        cfg.universe.subscribeBatch = u.value("subscribeBatch", cfg.universe.subscribeBatch);
+        cfg.universe.readyTimeoutSec = u.value("readyTimeoutSec", cfg.universe.readyTimeoutSec);
+    }
+
+    cfg.startup.readyTimeoutSec = cfg.universe.readyTimeoutSec;
+    if (config.contains("startup")) {
+        const auto& st = config["startup"];
+        cfg.startup.readyTimeoutSec = st.value("readyTimeoutSec", cfg.startup.readyTimeoutSec);
+        cfg.startup.warmUpRounds = st.value("warmUpRounds", cfg.startup.warmUpRounds);
+        cfg.startup.prefault = st.value("prefault", cfg.startup.prefault);
+    }
+
+    cfg.pipeline.busyPoll = cfg.runtime.busyPoll;
+    cfg.pipeline.prefault = cfg.startup.prefault;
+    cfg.pipeline.statsLogIntervalSec = cfg.statsLogIntervalSec;
+    if (config.contains("pipeline")) {
+        const auto& pl = config["pipeline"];
+        cfg.pipeline.enabled = pl.value("enabled", cfg.pipeline.enabled);
+        cfg.pipeline.builderThreads = pl.value("builderThreads", cfg.pipeline.builderThreads);
+        cfg.pipeline.builderCores = pl.value("builderCores", cfg.pipeline.builderCores);
+        cfg.pipeline.queueDepth = pl.value("queueDepth", cfg.pipeline.queueDepth);
+        cfg.pipeline.busyPoll = pl.value("busyPoll", cfg.pipeline.busyPoll);
     }
+
+    if (config.contains("tickStore")) {
+        const auto& ts = config["tickStore"];
+        cfg.tickStore.enabled = ts.value("enabled", cfg.tickStore.enabled);
+        cfg.tickStore.dir = ts.value("dir", cfg.tickStore.dir);
+        cfg.tickStore.compress = ts.value("compress", cfg.tickStore.compress);
+        cfg.tickStore.chunkRows = ts.value("chunkRows", cfg.tickStore.chunkRows);
+        cfg.tickStore.flushIntervalSec = ts.value("flushIntervalSec", cfg.tickStore.flushIntervalSec);
+        cfg.tickStore.queueDepth = ts.value("queueDepth", cfg.tickStore.queueDepth);
+    }
+
+    if (config.contains("admin")) {
+        const auto& admin = config["admin"];
+        cfg.admin.enabled = admin.value("enabled", cfg.admin.enabled);
+        cfg.admin.socketPath = admin.value("socketPath", cfg.admin.socketPath);
+    }
+
+    return cfg;
+}
+
+// Load configuration from JSON file.
+void ConfigManager::load(const std::string& filePath) {
+    ConfigSnapshot cfg = parse(filePath);
+    {
+        std::lock_guard<std::mutex> lock(publishMutex_);
+        filePath_ = filePath;
+    }
+    publish(std::move(cfg));
+}
+
+bool ConfigManager::reload(const ReloadCheck& check) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(publishMutex_);
+        path = filePath_;
+    }
+
+    std::string rejected;
+    try {
+        ConfigSnapshot next = parse(path);
+
+        std::lock_guard<std::mutex> lock(publishMutex_);
+        if (!symbolOverride_.empty()) next.symbols = symbolOverride_;
+
+        // The engine interns new symbols on its thread, and interned names are never freed
+        size_t unseen = 0;
+        for (const auto& sym : next.symbols) unseen += symbolTable().find(sym) < 0;
+        if (symbolTable().size() + unseen > kMaxSymbols) {
+            rejected = std::to_string(unseen) + " new symbols would exceed the " + std::to_string(kMaxSymbols) +
+                       " this process can hold (" + std::to_string(symbolTable().size()) + " used)";
+        } else if (check) {
+            rejected = check(*current_.load(std::memory_order_relaxed), next);
+        }
+
+        if (rejected.empty()) {
+            const ConfigSnapshot* cfg = publishLocked(std::move(next));
+            Logger::info("Config reloaded from " + path + " (version " + std::to_string(cfg->version) + ")");
+            return true;
+        }
+    } catch (const std::exception& ex) {
+        rejected = ex.what();
+    }
+    Logger::error("Config reload failed, keeping current config: " + rejected);
+    return false;
+}
+
+// Old snapshots are retained rather than freed: readers hold plain pointers
+// with no reference counting, and reloads are rare enough that this stays small.
+const ConfigSnapshot* ConfigManager::publish(ConfigSnapshot next) {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    return publishLocked(std::move(next));
+}
+
+const ConfigSnapshot* ConfigManager::update(const std::function<void(ConfigSnapshot&)>& edit) {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    ConfigSnapshot next = *current_.load(std::memory_order_relaxed);
+    edit(next);
+    return publishLocked(std::move(next));
+}
+
+const ConfigSnapshot* ConfigManager::publishLocked(ConfigSnapshot next) {
+    next.version = current_.load(std::memory_order_relaxed)->version + 1;
+    published_.push_back(std::make_unique<const ConfigSnapshot>(std::move(next)));
+    const ConfigSnapshot* cfg = published_.back().get();
+    current_.store(cfg, std::memory_order_release);
+    return cfg;
+}
+
+void ConfigManager::overrideSymbols(std::vector<std::string> symbols) {
+    update([&symbols](ConfigSnapshot& next) {
+        symbolOverride_ = symbols;
+        next.symbols = std::move(symbols);
+    });
 }
 
 // Getters for configuration parameters.
 std::vector<std::string> ConfigManager::getSymbols() {
-    return symbols_;
+    return snapshot()->symbols;
 }
 
 std::string ConfigManager::getMode() {
-    return mode_;
+    return snapshot()->mode;
 }
 
 double ConfigManager::getFeesPercent() {
-    return feesPercent_;
+    return snapshot()->feesPercent;
 }
 
 double ConfigManager::getMaxPosUsd() {
-    return maxPosUsd_;
+    return snapshot()->maxPosUsd;
 }
 
 double ConfigManager::getMinSpreadPercent() {
-    return minSpreadPercent_;
+    return snapshot()->minSpreadPercent;
 }
 
 double ConfigManager::getRebalanceMinSpread() {
-    return rebalanceMinSpread_;
+    return snapshot()->rebalanceMinSpread;
 }
 
 double ConfigManager::getCheckIntervalSeconds() {
-    return checkIntervalSeconds_;
+    return snapshot()->checkIntervalSeconds;
 }
\ No newline at end of file
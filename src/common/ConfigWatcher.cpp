@@ -0,0 +1,95 @@
+#include "common/ConfigWatcher.hpp"
+#include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+
+namespace {
+    volatile std::sig_atomic_t reloadRequested = 0;
+
+    void onSighup(int) {
+        reloadRequested = 1;
+    }
+}
+
+ConfigWatcher::ConfigWatcher(std::string filePath, ReloadCallback onReload, double pollIntervalSec)
+    : filePath_(std::move(filePath)), onReload_(std::move(onReload)), pollIntervalSec_(pollIntervalSec) {}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+void ConfigWatcher::start() {
+    if (running_.exchange(true)) return;
+
+    fileChanged(); // Record the current modification time as the baseline
+#ifdef SIGHUP
+    std::signal(SIGHUP, onSighup);
+#endif
+
+    thread_ = std::thread([this]() { run(); });
+    Logger::info("Watching " + filePath_ + " for config changes (file change or SIGHUP)");
+}
+
+void ConfigWatcher::stop() {
+    if (!running_.exchange(false)) return;
+    if (thread_.joinable()) thread_.join();
+}
+
+ConfigWatcher::SymbolDiff ConfigWatcher::diffSymbols(const ConfigSnapshot& prev, const ConfigSnapshot& next) {
+    auto contains = [](const std::vector<std::string>& v, const std::string& s) {
+        return std::find(v.begin(), v.end(), s) != v.end();
+    };
+
+    SymbolDiff diff;
+    for (const auto& sym : next.symbols) {
+        if (!contains(prev.symbols, sym)) diff.added.push_back(sym);
+    }
+    for (const auto& sym : prev.symbols) {
+        if (!contains(next.symbols, sym)) diff.removed.push_back(sym);
+    }
+    return diff;
+}
+
+bool ConfigWatcher::fileChanged() {
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(filePath_, ec);
+    if (ec || mtime == lastWrite_) return false;
+    lastWrite_ = mtime;
+    return true;
+}
+
+void ConfigWatcher::run() {
+    RuntimeProfile::enterBackgroundThread();
+
+    // Poll in short steps so SIGHUP is picked up promptly.
+    const auto step = std::chrono::milliseconds(100);
+    auto nextFileCheck = std::chrono::steady_clock::now();
+
+    while (running_.load()) {
+        bool reload = false;
+        if (reloadRequested) {
+            reloadRequested = 0;
+            Logger::info("SIGHUP received, reloading config");
+            reload = true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextFileCheck) {
+            nextFileCheck = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(pollIntervalSec_));
+            if (fileChanged()) reload = true;
+        }
+
+        if (reload) {
+            const ConfigSnapshot* prev = ConfigManager::snapshot();
+            if (ConfigManager::reload(check_) && onReload_) {
+                onReload_(*prev, *ConfigManager::snapshot());
+            }
+        }
+
+        std::this_thread::sleep_for(step);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "common/HmacSha256.hpp"
+
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <stdexcept>
+#include <string>
+
+HmacSha256::HmacSha256(std::string_view key) {
+    mac_ = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+    ctx_ = mac_ ? EVP_MAC_CTX_new(mac_) : nullptr;
+    if (!ctx_) throw std::runtime_error("HmacSha256: failed to create OpenSSL MAC context");
+
+    char digest[] = "SHA256";
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+        OSSL_PARAM_construct_end()
+    };
+    // Key the context once; later begin() calls pass a null key to reuse it.
+    if (EVP_MAC_init(ctx_, reinterpret_cast<const unsigned char*>(key.data()), key.size(), params) != 1) {
+        throw std::runtime_error("HmacSha256: failed to initialise HMAC-SHA256");
+    }
+}
+
+HmacSha256::~HmacSha256() {
+    EVP_MAC_CTX_free(ctx_);
+    EVP_MAC_free(mac_);
+}
+
+bool HmacSha256::begin() {
+    return EVP_MAC_init(ctx_, nullptr, 0, nullptr) == 1;
+}
+
+bool HmacSha256::update(std::string_view data) {
+    return EVP_MAC_update(ctx_, reinterpret_cast<const unsigned char*>(data.data()), data.size()) == 1;
+}
+
+bool HmacSha256::finishHex(char* out) {
+    unsigned char digest[32];
+    size_t len = 0;
+    if (EVP_MAC_final(ctx_, digest, &len, sizeof(digest)) != 1 || len != sizeof(digest)) return false;
+
+    static constexpr char hex[] = "0123456789abcdef";
+    for (size_t i = 0; i < len; ++i) {
+        out[2 * i]     = hex[digest[i] >> 4];
+        out[2 * i + 1] = hex[digest[i] & 0x0f];
+    }
+    return true;
+}
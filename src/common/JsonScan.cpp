@@ -0,0 +1,23 @@
+#include "common/JsonScan.hpp"
+
+std::string_view jsonField(std::string_view body, std::string_view key) {
+    size_t pos = 0;
+    while ((pos = body.find(key, pos)) != std::string_view::npos) {
+        // Match "key" followed by optional spaces and a colon.
+        bool quoted = pos > 0 && body[pos - 1] == '"' && pos + key.size() < body.size() && body[pos + key.size()] == '"';
+        size_t p = pos + key.size() + 1;
+        pos += key.size();
+        if (!quoted) continue;
+        while (p < body.size() && body[p] == ' ') ++p;
+        if (p >= body.size() || body[p] != ':') continue;
+        ++p;
+        while (p < body.size() && body[p] == ' ') ++p;
+        if (p < body.size() && body[p] == '"') {
+            size_t end = body.find('"', p + 1);
+            return end == std::string_view::npos ? std::string_view{} : body.substr(p + 1, end - p - 1);
+        }
+        size_t end = body.find_first_of(",}", p);
+        return body.substr(p, end == std::string_view::npos ? std::string_view::npos : end - p);
+    }
+    return {};
+}
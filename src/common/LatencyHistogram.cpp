@@ -0,0 +1,43 @@
+#include "common/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+
+int LatencyHistogram::bucketFor(uint64_t v) {
+    if (v < (1u << kSubBits)) return static_cast<int>(v);
+    int exp = 63 - std::countl_zero(v);                       // Position of the highest set bit
+    int sub = static_cast<int>((v >> (exp - kSubBits)) & ((1u << kSubBits) - 1));
+    return ((exp - kSubBits + 1) << kSubBits) + sub;
+}
+
+int64_t LatencyHistogram::bucketUpperEdge(int bucket) {
+    if (bucket < (1 << kSubBits)) return bucket;
+    int exp = (bucket >> kSubBits) + kSubBits - 1;
+    int sub = bucket & ((1 << kSubBits) - 1);
+    uint64_t base = (uint64_t(1) << exp) | (uint64_t(sub) << (exp - kSubBits));
+    return static_cast<int64_t>(base + (uint64_t(1) << (exp - kSubBits)) - 1);
+}
+
+void LatencyHistogram::record(int64_t valueNs) {
+    uint64_t v = valueNs > 0 ? static_cast<uint64_t>(valueNs) : 0;
+    ++buckets_[bucketFor(v)];
+    ++count_;
+    max_ = std::max(max_, static_cast<int64_t>(v));
+}
+
+int64_t LatencyHistogram::percentile(double q) const {
+    if (count_ == 0) return 0;
+    uint64_t target = static_cast<uint64_t>(q * static_cast<double>(count_ - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += buckets_[i];
+        if (seen >= target) return std::min(bucketUpperEdge(i), max_);
+    }
+    return max_;
+}
+
+void LatencyHistogram::reset() {
+    buckets_.fill(0);
+    count_ = 0;
+    max_ = 0;
+}
@@ -1,29 +1,64 @@
 #include "common/Logger.hpp"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
-#include <iomanip>
+#include <cstdarg>
+#include <cstdio>
 #include <ctime>
-#include <sstream>
 
 namespace {
-    // Returns current timestamp as a formatted string.
-    std::string timestamp() {
+    // Writes the current timestamp into buf (no heap allocation).
+    const char* timestamp(char (&buf)[32]) {
         auto now = std::chrono::system_clock::now();
         auto in_time_t = std::chrono::system_clock::to_time_t(now);
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+        std::tm tm{};
+#if defined(_WIN32)
+        localtime_s(&tm, &in_time_t);
+#else
+        localtime_r(&in_time_t, &tm);
+#endif
+        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+        return buf;
     }
 }
 
-void Logger::info(const std::string& msg) {
-    std::cout << "[" << timestamp() << "] [INFO] " << msg << std::endl;
+void Logger::info(std::string_view msg) {
+    char ts[32];
+    std::cout << "[" << timestamp(ts) << "] [INFO] " << msg << std::endl;
 }
 
-void Logger::warn(const std::string& msg) {
-    std::cout << "[" << timestamp() << "] [WARN] " << msg << std::endl;
+void Logger::warn(std::string_view msg) {
+    char ts[32];
+    std::cout << "[" << timestamp(ts) << "] [WARN] " << msg << std::endl;
 }
 
-void Logger::error(const std::string& msg) {
-    std::cerr << "[" << timestamp() << "] [ERROR] " << msg << std::endl;
-}
\ No newline at end of file
+void Logger::error(std::string_view msg) {
+    char ts[32];
+    std::cerr << "[" << timestamp(ts) << "] [ERROR] " << msg << std::endl;
+}
+
+namespace {
+    // Formats into a thread-local buffer (no heap allocation); truncates long messages.
+    std::string_view vformat(const char* fmt, va_list args) {
+        thread_local char buf[1024];
+        int n = std::vsnprintf(buf, sizeof(buf), fmt, args);
+        if (n < 0) return {};
+        return std::string_view(buf, std::min<size_t>(static_cast<size_t>(n), sizeof(buf) - 1));
+    }
+}
+
+void Logger::infof(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    std::string_view msg = vformat(fmt, args);
+    va_end(args);
+    if (!msg.empty()) info(msg);
+}
+
+void Logger::warnf(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    std::string_view msg = vformat(fmt, args);
+    va_end(args);
+    if (!msg.empty()) warn(msg);
+}
@@ -0,0 +1,114 @@
+#include "common/RuntimeProfile.hpp"
+#include "common/Logger.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+RuntimeSettings RuntimeProfile::settings_;
+
+namespace {
+    std::atomic<unsigned> nextFeedCore{0};
+    thread_local bool feedThreadEntered = false;
+
+#if defined(__linux__)
+    constexpr int kMpolLocal = 4; // MPOL_LOCAL from <linux/mempolicy.h>
+#endif
+}
+
+void RuntimeProfile::configure(const RuntimeSettings& settings) {
+    settings_ = settings;
+
+    if (settings_.lockMemory) {
+#if defined(__linux__)
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            Logger::info("Runtime: memory locked (mlockall)");
+        } else {
+            Logger::warn("Runtime: mlockall failed: " + std::string(std::strerror(errno)) +
+                         " (check RLIMIT_MEMLOCK / CAP_IPC_LOCK)");
+        }
+#else
+        Logger::warn("Runtime: lockMemory is only supported on Linux");
+#endif
+    }
+
+    if (settings_.busyPoll) {
+        Logger::info(std::string("Runtime: busy-poll engine loop") +
+                     (settings_.pauseBackoff ? " with pause backoff" : ""));
+    }
+}
+
+bool RuntimeProfile::pinCurrentThread(int core) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        Logger::warn("Runtime: cannot pin thread to core " + std::to_string(core) + ": " + std::strerror(rc));
+        return false;
+    }
+    return true;
+#else
+    (void)core;
+    Logger::warn("Runtime: thread pinning is only supported on Linux");
+    return false;
+#endif
+}
+
+void RuntimeProfile::applyMemoryPolicy() {
+    if (!settings_.numaLocal) return;
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    // Pages first touched by this thread come from the node it is pinned to.
+    if (syscall(SYS_set_mempolicy, kMpolLocal, nullptr, 0) != 0) {
+        Logger::warn("Runtime: set_mempolicy(MPOL_LOCAL) failed: " + std::string(std::strerror(errno)));
+    }
+#endif
+}
+
+void RuntimeProfile::enterEngineThread() {
+    if (settings_.engineCore >= 0 && pinCurrentThread(settings_.engineCore)) {
+        Logger::info("Runtime: engine thread pinned to core " + std::to_string(settings_.engineCore));
+    }
+    applyMemoryPolicy();
+}
+
+void RuntimeProfile::enterBackgroundThread() {
+#if defined(__linux__)
+    if (settings_.engineCore < 0 && settings_.feedCores.empty()) return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int c = 0; c < cpus && c < CPU_SETSIZE; ++c) CPU_SET(c, &set);
+    if (settings_.engineCore >= 0) CPU_CLR(settings_.engineCore, &set);
+    for (int c : settings_.feedCores) CPU_CLR(c, &set);
+
+    if (CPU_COUNT(&set) > 0) pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+void RuntimeProfile::enterFeedThread() {
+    if (feedThreadEntered) return;
+    feedThreadEntered = true;
+
+    if (settings_.feedCores.empty()) {
+        enterBackgroundThread();
+        return;
+    }
+    unsigned idx = nextFeedCore.fetch_add(1, std::memory_order_relaxed) % settings_.feedCores.size();
+    int core = settings_.feedCores[idx];
+    if (pinCurrentThread(core)) {
+        Logger::info("Runtime: feed thread pinned to core " + std::to_string(core));
+    }
+    applyMemoryPolicy();
+}
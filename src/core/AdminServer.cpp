@@ -0,0 +1,340 @@
+#include "core/AdminServer.hpp"
+#include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+#include "core/Interner.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    constexpr int kPollMs = 200; // How often the server notices stop()
+
+    nlohmann::json error(const std::string& message) {
+        return { {"error", message} };
+    }
+
+    nlohmann::json levelsJson(const std::vector<OrderBook::PriceLevel>& levels) {
+        nlohmann::json out = nlohmann::json::array();
+        for (const auto& [price, qty] : levels) out.push_back({ price, qty });
+        return out;
+    }
+
+    bool writeAll(int fd, const std::string& data) {
+        size_t off = 0;
+        while (off < data.size()) {
+            ssize_t n = ::send(fd, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            off += static_cast<size_t>(n);
+        }
+        return true;
+    }
+}
+
+AdminServer::AdminServer(AdminSettings settings, ArbitrageEngine& engine,
+                         std::vector<std::shared_ptr<IExchangeClient>> clients)
+    : settings_(std::move(settings)), engine_(engine), clients_(std::move(clients)) {}
+
+AdminServer::~AdminServer() {
+    stop();
+}
+
+bool AdminServer::start() {
+    if (running_.load()) return true;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (settings_.socketPath.size() >= sizeof(addr.sun_path)) {
+        Logger::error("Admin socket path is too long: " + settings_.socketPath);
+        return false;
+    }
+    std::strncpy(addr.sun_path, settings_.socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        Logger::error("Admin socket: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    ::unlink(settings_.socketPath.c_str()); // Left behind by a previous run
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::chmod(settings_.socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 || ::listen(fd, 4) != 0) {
+        Logger::error("Admin socket " + settings_.socketPath + ": " + std::strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    listenFd_ = fd;
+    running_ = true;
+    thread_ = std::thread([this]() { run(); });
+    Logger::info("Admin commands on " + settings_.socketPath);
+    return true;
+}
+
+void AdminServer::stop() {
+    if (!running_.exchange(false)) return;
+    if (thread_.joinable()) thread_.join();
+    ::close(listenFd_);
+    listenFd_ = -1;
+    ::unlink(settings_.socketPath.c_str());
+}
+
+void AdminServer::run() {
+    RuntimeProfile::enterBackgroundThread();
+
+    // One operator connection at a time is plenty; poll so stop() is noticed promptly.
+    while (running_.load()) {
+        pollfd pfd{ listenFd_, POLLIN, 0 };
+        if (::poll(&pfd, 1, kPollMs) <= 0) continue;
+        int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) continue;
+        serve(fd);
+        ::close(fd);
+    }
+}
+
+void AdminServer::serve(int fd) {
+    std::string buffer;
+    char chunk[1024];
+    while (running_.load()) {
+        pollfd pfd{ fd, POLLIN, 0 };
+        int ready = ::poll(&pfd, 1, kPollMs);
+        if (ready == 0) continue;
+        if (ready < 0) return;
+
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return; // Closed by the client
+        buffer.append(chunk, static_cast<size_t>(n));
+
+        size_t eol;
+        while ((eol = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, eol);
+            buffer.erase(0, eol + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+            if (!writeAll(fd, execute(line).dump() + "\n")) return;
+        }
+        if (buffer.size() > 64 * 1024) return; // Not a command stream
+    }
+}
+
+nlohmann::json AdminServer::execute(const std::string& line) {
+    std::istringstream in(line);
+    std::vector<std::string> args;
+    for (std::string word; in >> word;) args.push_back(word);
+    if (args.empty()) return error("empty command");
+
+    // Venue names contain spaces: the tail of the line after the first two words
+    auto rest = [&args](size_t from) {
+        std::string out;
+        for (size_t i = from; i < args.size(); ++i) out += (i > from ? " " : "") + args[i];
+        return out;
+    };
+
+    const std::string& cmd = args[0];
+    try {
+        if (cmd == "help") return help();
+        if (cmd == "status") return status();
+        if (cmd == "dump" && args.size() >= 2) {
+            return dump(args[1], args.size() >= 3 ? std::stoul(args[2]) : 5);
+        }
+        if ((cmd == "pause" || cmd == "resume") && args.size() >= 3) {
+            return pause({ args[1], rest(2) }, cmd == "pause");
+        }
+        if (cmd == "flatten" && args.size() == 2) return flatten(args[1]);
+        if (cmd == "set" && args.size() == 3) return set(args[1], args[2]);
+        if (cmd == "resubscribe" && args.size() == 2) return resubscribe(args[1]);
+    } catch (const std::exception& ex) {
+        return error(cmd + ": " + ex.what());
+    }
+    return error("unknown or malformed command: " + line + " (try \"help\")");
+}
+
+nlohmann::json AdminServer::help() const {
+    return { {"commands", {
+        "status",
+        "dump SYMBOL [LEVELS]",
+        "pause symbol SYMBOL | pause venue VENUE NAME",
+        "resume symbol SYMBOL | resume venue VENUE NAME",
+        "flatten SYMBOL|all",
+        "set minSpreadPercent|rebalanceMinSpread|maxPosUsd|checkIntervalSec|adaptiveStddevMult VALUE",
+        "resubscribe SYMBOL|all"
+    } } };
+}
+
+int64_t AdminServer::symbolId(const std::string& symbol) const {
+    const auto& symbols = ConfigManager::snapshot()->symbols;
+    if (std::find(symbols.begin(), symbols.end(), symbol) == symbols.end()) return -1;
+    return symbolTable().find(symbol);
+}
+
+nlohmann::json AdminServer::status() const {
+    const ConfigSnapshot* cfg = ConfigManager::snapshot();
+
+    nlohmann::json venues = nlohmann::json::array();
+    for (const auto& client : clients_) {
+        std::string name = client->getExchangeName();
+        int64_t id = venueTable().find(name);
+        venues.push_back({ {"name", name}, {"paused", id >= 0 && engine_.venuePaused(static_cast<VenueId>(id))} });
+    }
+
+    nlohmann::json symbols = nlohmann::json::array();
+    double totalPnl = 0.0;
+    for (const auto& symbol : cfg->symbols) {
+        int64_t id = symbolTable().find(symbol);
+        if (id < 0) continue;
+        ArbitrageEngine::PositionSnapshot pos = engine_.positions(static_cast<SymbolId>(id));
+        nlohmann::json positions = nlohmann::json::object();
+        for (size_t v = 0; v < venueTable().size(); ++v) {
+            if (pos.usd[v] != 0.0) positions[venueTable().name(static_cast<uint32_t>(v))] = pos.usd[v];
+        }
+        totalPnl += pos.pnl;
+        symbols.push_back({ {"symbol", symbol}, {"paused", engine_.symbolPaused(static_cast<SymbolId>(id))},
+                            {"pnl", pos.pnl}, {"positionsUsd", positions} });
+    }
+
+    return {
+        {"configVersion", cfg->version},
+        {"mode", cfg->mode},
+        {"minSpreadPercent", cfg->minSpreadPercent},
+        {"rebalanceMinSpread", cfg->rebalanceMinSpread},
+        {"maxPosUsd", cfg->maxPosUsd},
+        {"checkIntervalSec", cfg->checkIntervalSeconds},
+        {"pnl", totalPnl},
+        {"venues", venues},
+        {"symbols", symbols}
+    };
+}
+
+nlohmann::json AdminServer::dump(const std::string& symbol, size_t levels) const {
+    int64_t id = symbolId(symbol);
+    if (id < 0) return error("unknown symbol " + symbol);
+    levels = std::clamp<size_t>(levels, 1, ConsolidatedBook::kSnapshotLevels);
+
+    // Each venue book is copied under its lock once, bounded by `levels`
+    nlohmann::json venues = nlohmann::json::array();
+    std::vector<OrderBook::PriceLevel> bids, asks;
+    for (const auto& client : clients_) {
+        auto ob = client->getOrderBook(symbol);
+        if (!ob) continue;
+        OrderBook::TopOfBook top = ob->getTop();
+        ob->copyTopNBids(levels, bids);
+        ob->copyTopNAsks(levels, asks);
+        venues.push_back({ {"venue", client->getExchangeName()}, {"version", top.version},
+                           {"bids", levelsJson(bids)}, {"asks", levelsJson(asks)} });
+    }
+
+    nlohmann::json merged = nullptr;
+    if (const ConsolidatedBook* book = engine_.findConsolidatedBook(static_cast<SymbolId>(id))) {
+        auto snap = std::make_unique<ConsolidatedBook::Snapshot>();
+        book->read(*snap);
+        auto side = [&](const std::array<ConsolidatedBook::Level, ConsolidatedBook::kSnapshotLevels>& src, size_t count) {
+            nlohmann::json out = nlohmann::json::array();
+            for (size_t i = 0; i < std::min(count, levels); ++i) out.push_back({ src[i].price, src[i].qty });
+            return out;
+        };
+        ConsolidatedBook::CrossedRegion crossed = ConsolidatedBook::crossedRegion(*snap);
+        merged = { {"version", snap->version}, {"bids", side(snap->bids, snap->bidCount)},
+                   {"asks", side(snap->asks, snap->askCount)},
+                   {"crossedQty", crossed.qty}, {"crossedEdge", crossed.edge()} };
+    }
+
+    ArbitrageEngine::PositionSnapshot pos = engine_.positions(static_cast<SymbolId>(id));
+    nlohmann::json positions = nlohmann::json::object();
+    for (const auto& client : clients_) {
+        std::string name = client->getExchangeName();
+        int64_t venue = venueTable().find(name);
+        positions[name] = venue >= 0 ? pos.usd[venue] : 0.0;
+    }
+
+    return {
+        {"symbol", symbol},
+        {"paused", engine_.symbolPaused(static_cast<SymbolId>(id))},
+        {"pnl", pos.pnl},
+        {"positionsUsd", positions},
+        {"books", venues},
+        {"consolidated", merged}
+    };
+}
+
+nlohmann::json AdminServer::pause(const std::vector<std::string>& args, bool paused) {
+    const std::string& kind = args[0];
+    const std::string& name = args[1];
+    if (kind == "symbol") {
+        int64_t id = symbolId(name);
+        if (id < 0) return error("unknown symbol " + name);
+        engine_.pauseSymbol(static_cast<SymbolId>(id), paused);
+    } else if (kind == "venue") {
+        int64_t id = venueTable().find(name);
+        if (id < 0) return error("unknown venue " + name);
+        engine_.pauseVenue(static_cast<VenueId>(id), paused);
+    } else {
+        return error("expected \"symbol\" or \"venue\"");
+    }
+    Logger::info(std::string("Admin: ") + (paused ? "paused " : "resumed ") + kind + " " + name);
+    return { {"ok", true}, {kind, name}, {"paused", paused} };
+}
+
+nlohmann::json AdminServer::flatten(const std::string& symbol) {
+    std::vector<std::string> targets;
+    if (symbol == "all") {
+        targets = ConfigManager::snapshot()->symbols;
+    } else {
+        if (symbolId(symbol) < 0) return error("unknown symbol " + symbol);
+        targets.push_back(symbol);
+    }
+    for (const auto& target : targets) {
+        int64_t id = symbolTable().find(target);
+        if (id >= 0) engine_.requestFlatten(static_cast<SymbolId>(id));
+    }
+    Logger::info("Admin: flatten requested for " + symbol);
+    return { {"ok", true}, {"queued", targets} };
+}
+
+nlohmann::json AdminServer::set(const std::string& key, const std::string& value) {
+    size_t used = 0;
+    double v = std::stod(value, &used);
+    if (used != value.size()) return error("not a number: " + value);
+
+    double ConfigSnapshot::*field = nullptr;
+    if (key == "minSpreadPercent") field = &ConfigSnapshot::minSpreadPercent;
+    else if (key == "rebalanceMinSpread") field = &ConfigSnapshot::rebalanceMinSpread;
+    else if (key == "maxPosUsd") field = &ConfigSnapshot::maxPosUsd;
+    else if (key == "checkIntervalSec") field = &ConfigSnapshot::checkIntervalSeconds;
+    else if (key == "adaptiveStddevMult") field = &ConfigSnapshot::adaptiveStddevMult;
+    else return error("cannot set " + key);
+    if (!std::isfinite(v) || v <= 0.0) return error(key + " must be a positive number, got " + value);
+
+    // Edits the latest snapshot under the writer lock, so a concurrent reload is not undone.
+    // The engine picks it up on its next scan; a later file reload replaces it.
+    const ConfigSnapshot* cfg = ConfigManager::update([field, v](ConfigSnapshot& next) { next.*field = v; });
+    Logger::info("Admin: set " + key + "=" + value + " (config version " + std::to_string(cfg->version) + ")");
+    return { {"ok", true}, {key, v}, {"configVersion", cfg->version} };
+}
+
+nlohmann::json AdminServer::resubscribe(const std::string& symbol) {
+    std::vector<std::string> targets;
+    if (symbol == "all") {
+        targets = ConfigManager::snapshot()->symbols;
+    } else {
+        if (symbolId(symbol) < 0) return error("unknown symbol " + symbol);
+        targets.push_back(symbol);
+    }
+
+    // Fresh books replace the old ones; the engine re-attaches them on its next scan
+    for (const auto& client : clients_) {
+        for (const auto& target : targets) client->unsubscribeOrderBook(target);
+        client->subscribeOrderBooks(targets);
+    }
+    Logger::info("Admin: resubscribed " + symbol);
+    return { {"ok", true}, {"resubscribed", targets} };
+}
@@ -1,38 +1,400 @@
 #include "core/ArbitrageEngine.hpp"
 #include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+#include <algorithm>
+#include <cmath>
 #include <thread>
 #include <chrono>
 #include <limits>
 
+namespace {
+    int64_t nowNs() {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
 void ArbitrageEngine::addExchangeClient(const std::shared_ptr<IExchangeClient>& client) {
-    exchanges_.push_back(client);
+    exchanges_.push_back({ client, static_cast<VenueId>(venueTable().intern(client->getExchangeName())) });
+    venueIds_[exchanges_.size() - 1] = exchanges_.back().id;
 }
 
 void ArbitrageEngine::addExecutor(const std::string& exchangeName,
                                   const std::shared_ptr<ITradeExecutor>& exec) {
-    executors_[exchangeName] = exec;
+    executors_[venueTable().intern(exchangeName)] = exec;
+}
+
+void ArbitrageEngine::setLotSize(const std::string& exchangeName, const std::string& symbol, double lotSize) {
+    VenueId venue = static_cast<VenueId>(venueTable().intern(exchangeName));
+    SymbolId id = static_cast<SymbolId>(symbolTable().intern(symbol));
+    lotSize_[posIndex(venue, id)] = lotSize;
+}
+
+void ArbitrageEngine::setTickStore(std::shared_ptr<TickStore> store) {
+    tickStore_ = std::move(store);
+    ticks_ = tickStore_.get();
+}
+
+void ArbitrageEngine::refreshConfig() {
+    const ConfigSnapshot* cfg = ConfigManager::snapshot();
+    if (cfg == config_) return;
+
+    if (config_) {
+        Logger::info("Engine applying config version " + std::to_string(cfg->version) +
+                     " (" + std::to_string(cfg->symbols.size()) + " symbols)");
+    }
+
+    config_ = cfg;
+    minSpreadPercent_ = cfg->minSpreadPercent;
+    checkIntervalSec_ = cfg->checkIntervalSeconds;
+    maxPosUsd_ = cfg->maxPosUsd;
+    rebalanceMinSpread_ = cfg->rebalanceMinSpread;
+    adaptiveThreshold_ = cfg->adaptiveThreshold;
+    adaptiveStddevMult_ = cfg->adaptiveStddevMult;
+    adaptiveMinSamples_ = cfg->adaptiveMinSamples;
+    statsLogIntervalSec_ = cfg->statsLogIntervalSec;
+    busyPoll_ = cfg->runtime.busyPoll;
+    pauseBackoff_ = cfg->runtime.pauseBackoff;
+    risk_.configure(cfg->risk);
+    rebalancer_.configure(cfg->rebalance);
+
+    // Intern symbols once here so the scan loop works on ids only.
+    symbols_.clear();
+    for (const auto& sym : cfg->symbols) {
+        symbols_.push_back(static_cast<SymbolId>(symbolTable().intern(sym)));
+    }
+
+    // Size per-symbol state up front; existing statistics survive reloads.
+    symbolState_.resize(symbolTable().size());
+    size_t pairCount = exchanges_.size() * exchanges_.size();
+    for (SymbolId symbol : symbols_) {
+        SymbolState& state = symbolState_[symbol];
+        if (state.pairs.size() != pairCount) state.pairs.resize(pairCount);
+        if (!state.consolidated) {
+            state.consolidated = std::make_shared<ConsolidatedBook>();
+            for (const auto& venue : exchanges_) state.consolidated->setFeePercent(venue.id, cfg->feesPercent);
+            consolidatedOut_[symbol].store(state.consolidated.get(), std::memory_order_release);
+        }
+    }
+}
+
+void ArbitrageEngine::updateSpreadStats(SymbolId symbol, SymbolState& state, const OrderBook::TopOfBook* tops,
+                                        const bool* valid, int64_t nowNs) {
+    size_t n = exchanges_.size();
+    for (size_t buy = 0; buy < n; ++buy) {
+        if (!valid[buy] || tops[buy].ask <= 0.0) continue;
+        for (size_t sell = 0; sell < n; ++sell) {
+            if (sell == buy || !valid[sell] || tops[sell].bid <= 0.0) continue;
+            double spreadPct = ((tops[sell].bid - tops[buy].ask) / tops[buy].ask) * 100.0;
+            state.pairs[buy * n + sell].update(spreadPct, minSpreadPercent_, nowNs);
+            if (ticks_) ticks_->recordSpread(symbol, exchanges_[buy].id, exchanges_[sell].id, spreadPct);
+        }
+    }
+}
+
+double ArbitrageEngine::entryThreshold(const SpreadStats& stats) const {
+    if (!adaptiveThreshold_ || stats.samples() < adaptiveMinSamples_) return minSpreadPercent_;
+    return std::max(minSpreadPercent_, stats.ewma() + adaptiveStddevMult_ * stats.stddev());
+}
+
+SpreadStatsSnapshot ArbitrageEngine::spreadStats(SymbolId symbol, VenueId buyVenue, VenueId sellVenue) const {
+    if (symbol >= symbolState_.size()) return {};
+
+    size_t n = exchanges_.size(), buy = n, sell = n;
+    for (size_t i = 0; i < n; ++i) {
+        if (exchanges_[i].id == buyVenue) buy = i;
+        if (exchanges_[i].id == sellVenue) sell = i;
+    }
+    const auto& pairs = symbolState_[symbol].pairs;
+    if (buy == n || sell == n || buy * n + sell >= pairs.size()) return {};
+    return pairs[buy * n + sell].snapshot(nowNs());
+}
+
+std::shared_ptr<const ConsolidatedBook> ArbitrageEngine::consolidatedBook(SymbolId symbol) const {
+    if (symbol >= symbolState_.size()) return nullptr;
+    return symbolState_[symbol].consolidated;
+}
+
+void ArbitrageEngine::logSpreadStats() {
+    if (detectLatency_.count() > 0) {
+        Logger::infof("LATENCY book->engine (%s) | n=%llu p50=%lldus p99=%lldus p99.9=%lldus max=%lldus "
+                      "| versions seen=%llu conflated=%llu",
+                      busyPoll_ ? "busy-poll" : "sleep", static_cast<unsigned long long>(detectLatency_.count()),
+                      static_cast<long long>(detectLatency_.percentile(0.50) / 1000),
+                      static_cast<long long>(detectLatency_.percentile(0.99) / 1000),
+                      static_cast<long long>(detectLatency_.percentile(0.999) / 1000),
+                      static_cast<long long>(detectLatency_.max() / 1000),
+                      static_cast<unsigned long long>(observedVersions_),
+                      static_cast<unsigned long long>(conflatedVersions_));
+        detectLatency_.reset();
+    }
+    observedVersions_ = conflatedVersions_ = 0;
+
+    Logger::infof("RISK pnl=$%f gross=$%f net=$%f%s | rejects rate=%llu notional=%llu exposure=%llu "
+                  "duplicate=%llu self=%llu killed=%llu",
+                  risk_.pnl(), risk_.grossUsd(), risk_.netUsd(), risk_.killed() ? " KILLED" : "",
+                  static_cast<unsigned long long>(risk_.rejects(RiskReject::RateLimit)),
+                  static_cast<unsigned long long>(risk_.rejects(RiskReject::OrderNotional)),
+                  static_cast<unsigned long long>(risk_.rejects(RiskReject::SymbolGross) +
+                                                  risk_.rejects(RiskReject::SymbolNet) +
+                                                  risk_.rejects(RiskReject::GlobalGross) +
+                                                  risk_.rejects(RiskReject::GlobalNet)),
+                  static_cast<unsigned long long>(risk_.rejects(RiskReject::Duplicate)),
+                  static_cast<unsigned long long>(risk_.rejects(RiskReject::SelfTrade)),
+                  static_cast<unsigned long long>(risk_.rejects(RiskReject::KillSwitch)));
+
+    int64_t now = nowNs();
+    size_t n = exchanges_.size();
+    ConsolidatedBook::Snapshot book;
+    for (SymbolId symbol : symbols_) {
+        if (const auto& consolidated = symbolState_[symbol].consolidated) {
+            consolidated->read(book);
+            if (book.bidCount > 0 && book.askCount > 0) {
+                ConsolidatedBook::CrossedRegion crossed = ConsolidatedBook::crossedRegion(book);
+                Logger::infof("BOOK %s | net bid=%f (%f) net ask=%f (%f) | crossed qty=%f edge=%f levels=%zu/%zu",
+                              symbolTable().name(symbol).c_str(), book.bids[0].price, book.bids[0].qty,
+                              book.asks[0].price, book.asks[0].qty, crossed.qty, crossed.edge(),
+                              crossed.bidLevels, crossed.askLevels);
+            }
+        }
+
+        const auto& pairs = symbolState_[symbol].pairs;
+        for (size_t buy = 0; buy < n; ++buy) {
+            for (size_t sell = 0; sell < n; ++sell) {
+                if (buy == sell || pairs[buy * n + sell].samples() == 0) continue;
+                SpreadStatsSnapshot st = pairs[buy * n + sell].snapshot(now);
+                Logger::infof("STATS %s | BUY %s SELL %s | n=%llu last=%.4f%% ewma=%.4f%% sd=%.4f%% "
+                              "p50=%.4f%% p90=%.4f%% p99=%.4f%% | opps=%llu avg=%.0fms max=%.0fms threshold=%.4f%%",
+                              symbolTable().name(symbol).c_str(),
+                              venueTable().name(exchanges_[buy].id).c_str(),
+                              venueTable().name(exchanges_[sell].id).c_str(),
+                              static_cast<unsigned long long>(st.samples), st.last, st.ewma, st.stddev,
+                              st.p50, st.p90, st.p99, static_cast<unsigned long long>(st.opportunities),
+                              st.avgOpportunityMs, st.maxOpportunityMs, entryThreshold(pairs[buy * n + sell]));
+            }
+        }
+    }
+}
+
+void ArbitrageEngine::requestFlatten(SymbolId symbol) {
+    flattenRequested_[symbol].store(true, std::memory_order_relaxed);
+    controlPending_.store(true, std::memory_order_release);
+}
+
+void ArbitrageEngine::runControl() {
+    // Cleared first: a request arriving meanwhile sets it again for the next scan
+    controlPending_.store(false, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    for (size_t symbol = 0; symbol < symbolTable().size(); ++symbol) {
+        if (symbolPending_[symbol] > 0 && flattenRequested_[symbol].load(std::memory_order_relaxed)) {
+            // Closes the position once the fills in flight have landed in it
+            controlPending_.store(true, std::memory_order_relaxed);
+            continue;
+        }
+        if (flattenRequested_[symbol].exchange(false, std::memory_order_relaxed)) {
+            flatten(static_cast<SymbolId>(symbol));
+        }
+    }
+}
+
+void ArbitrageEngine::flatten(SymbolId symbol) {
+    const std::string& symbolName = symbolTable().name(symbol);
+    Logger::info("Flattening " + symbolName);
+
+    for (const auto& venue : exchanges_) {
+        double pos = activePositionsUsd_[posIndex(venue.id, symbol)].usd;
+        if (pos == 0.0) continue;
+
+        const std::string& venueName = venueTable().name(venue.id);
+        ITradeExecutor* exec = executors_[venue.id].get();
+        auto ob = venue.client->getOrderBook(symbolName);
+        if (!exec || !ob) {
+            Logger::warn("Cannot flatten " + symbolName + " on " + venueName + ": no executor or book");
+            continue;
+        }
+
+        // Positions are tracked as USD notional, so that is what gets closed
+        Side side = pos > 0.0 ? Side::Sell : Side::Buy;
+        OrderBook::TopOfBook top = ob->getTop();
+        double price = side == Side::Sell ? top.bid : top.ask;
+        double qty = price > 0.0 ? std::fabs(pos) / price : 0.0;
+        double lot = lotSize_[posIndex(venue.id, symbol)];
+        if (lot > 0.0) qty = std::floor(qty / lot + 1e-9) * lot;
+        if (qty <= 0.0) {
+            Logger::warn("Cannot flatten " + symbolName + " on " + venueName + ": no price or below one lot");
+            continue;
+        }
+
+        if (activeTrades_ == kMaxOpenTrades) {
+            Logger::warn("Cannot flatten " + symbolName + " on " + venueName + ": too many trades in flight");
+            return;
+        }
+        Order* order = orders_.acquire();
+        if (!order) {
+            Logger::error("Order pool exhausted");
+            return;
+        }
+        *order = { order->id, symbol, venue.id, side, price, qty, 0 };
+
+        // An operator action skips the risk gate (the kill switch may be why it is needed),
+        // but the gate still tracks the order and its exposure
+        const Order* legs[1] = { order };
+        order->ts = nowNs();
+        risk_.onSend(legs, 1, order->ts);
+        OpenTrade trade;
+        trade.kind = TradeKind::Flatten;
+        trade.symbol = symbol;
+        trade.legs = 1;
+        trade.fills[0] = exec->executeTrade(*order);
+        orders_.release(order);
+        track(trade);
+    }
+}
+
+void ArbitrageEngine::track(OpenTrade trade) {
+    for (uint8_t i = 0; i < trade.legs; ++i) {
+        if (trade.fills[i].pending) ++trade.pending;
+        else applyFill(trade.fills[i]);
+    }
+    if (trade.pending == 0) {
+        finishTrade(trade);
+        return;
+    }
+
+    // Callers check for a free slot before sending
+    for (OpenTrade& slot : openTrades_) {
+        if (slot.active) continue;
+        slot = trade;
+        slot.active = true;
+        ++activeTrades_;
+        pendingLegs_ += trade.pending;
+        ++symbolPending_[trade.symbol];
+        return;
+    }
+    Logger::error("No slot for a trade in flight on " + symbolTable().name(trade.symbol));
+}
+
+void ArbitrageEngine::collectFills() {
+    std::array<Fill, 16> batch;
+    for (const auto& exec : executors_) {
+        if (!exec) continue;
+        size_t n;
+        while ((n = exec->pollFills(batch.data(), batch.size())) > 0) {
+            for (size_t i = 0; i < n; ++i) settleLeg(batch[i]);
+        }
+    }
 }
 
-void ArbitrageEngine::setSymbols(const std::vector<std::string>& symbols) {
-    symbols_ = symbols;
+void ArbitrageEngine::settleLeg(const Fill& fill) {
+    for (OpenTrade& trade : openTrades_) {
+        if (!trade.active) continue;
+        for (uint8_t i = 0; i < trade.legs; ++i) {
+            Fill& leg = trade.fills[i];
+            if (!leg.pending || leg.orderId != fill.orderId) continue;
+
+            leg = fill;
+            leg.pending = false;
+            applyFill(leg);
+            --pendingLegs_;
+            if (--trade.pending == 0) {
+                trade.active = false;
+                --activeTrades_;
+                --symbolPending_[trade.symbol];
+                finishTrade(trade);
+            }
+            return;
+        }
+    }
+    Logger::warnf("Fill for unknown order %llu on %s", static_cast<unsigned long long>(fill.orderId),
+                  venueTable().name(fill.venue).c_str());
 }
 
-void ArbitrageEngine::setConfig(double minSpreadPercent, double checkIntervalSec, double maxPosUsd, double rebalanceMinSpread) {
-    minSpreadPercent_ = minSpreadPercent;
-    checkIntervalSec_ = checkIntervalSec;
-    maxPosUsd_ = maxPosUsd;
-    rebalanceMinSpread_ = rebalanceMinSpread;
+void ArbitrageEngine::applyFill(const Fill& fill) {
+    risk_.onFill(fill);
+    if (fill.ok) applyPositionUpdate(fill.venue, fill.symbol, fill.side, fill.cost);
+}
+
+void ArbitrageEngine::finishTrade(const OpenTrade& trade) {
+    SymbolId symbol = trade.symbol;
+    const char* symbolName = symbolTable().name(symbol).c_str();
+
+    if (trade.kind == TradeKind::Flatten) {
+        const Fill& fill = trade.fills[0];
+        const char* venueName = venueTable().name(fill.venue).c_str();
+        if (fill.ok) {
+            Logger::infof("FLATTEN %s | %s %s qty=%f @ %f | pos=$%f", symbolName, venueName, sideName(fill.side),
+                          fill.qty, fill.price, activePositionsUsd_[posIndex(fill.venue, symbol)].usd);
+        } else {
+            Logger::warnf("Flatten order for %s on %s was not filled", symbolName, venueName);
+        }
+        positionsChanged(symbol);
+        return;
+    }
+
+    const Fill& buyFill = trade.fills[0];
+    const Fill& sellFill = trade.fills[1];
+    const char* buyName = venueTable().name(buyFill.venue).c_str();
+    const char* sellName = venueTable().name(sellFill.venue).c_str();
+    double buyPos = activePositionsUsd_[posIndex(buyFill.venue, symbol)].usd;
+    double sellPos = activePositionsUsd_[posIndex(sellFill.venue, symbol)].usd;
+
+    // Handle partials conservatively
+    double execUSD = (buyFill.ok && sellFill.ok) ? std::min(buyFill.cost, sellFill.cost) : 0.0;
+    double net = 0.0;
+    if (execUSD > 0.0) {
+        // Pair PnL, net of both legs' fees
+        double gross = ((sellFill.price - buyFill.price) / buyFill.price) * execUSD;
+        net = gross - (buyFill.fee + sellFill.fee);
+        cumulativePnl_[symbol] += net;
+        risk_.onPnl(net);
+    }
+
+    if (!buyFill.ok && !sellFill.ok) {
+        if (trade.kind == TradeKind::Unwind) Logger::warnf("Unwind for %s was not filled", symbolName);
+        return;
+    }
+    positionsChanged(symbol);
+
+    // A one-sided fill still moved that venue's position, so a naked leg counts
+    // against the limits and can be unwound (an unwind leg included)
+    if (buyFill.ok != sellFill.ok) {
+        const Fill& filled = buyFill.ok ? buyFill : sellFill;
+        const Fill& missed = buyFill.ok ? sellFill : buyFill;
+        Logger::warnf("ORPHAN %s%s | %s on %s filled qty=%f @ %f, %s on %s did not | %s pos=$%f | %s pos=$%f",
+                      symbolName, trade.kind == TradeKind::Unwind ? " (unwind)" : "", sideName(filled.side),
+                      venueTable().name(filled.venue).c_str(), filled.qty, filled.price, sideName(missed.side),
+                      venueTable().name(missed.venue).c_str(), buyName, buyPos, sellName, sellPos);
+        return;
+    }
+
+    if (trade.kind == TradeKind::Unwind) {
+        Logger::infof("UNWIND %s | netPnL=$%f | cumPnL=$%f | %s pos=$%f | %s pos=$%f",
+                      symbolName, net, cumulativePnl_[symbol], sellName, sellPos, buyName, buyPos);
+        return;
+    }
+    if (execUSD <= 0.0) return;
+
+    Logger::infof("EXEC %s | total=$%f | netPnL=$%f | cumPnL=$%f | %s pos=$%f | %s pos=$%f",
+                  symbolName, execUSD, net, cumulativePnl_[symbol], buyName, buyPos, sellName, sellPos);
+}
+
+void ArbitrageEngine::positionsChanged(SymbolId symbol) {
+    PositionSnapshot snap;
+    std::array<double, kMaxVenues> byIndex{};
+    for (size_t i = 0; i < exchanges_.size(); ++i) {
+        byIndex[i] = activePositionsUsd_[posIndex(exchanges_[i].id, symbol)].usd;
+        snap.usd[exchanges_[i].id] = byIndex[i];
+    }
+    snap.pnl = cumulativePnl_[symbol];
+    positions_[symbol].store(snap);
+    rebalancer_.onPositions(symbol, byIndex.data(), exchanges_.size());
 }
 
 // Calculate remaining USD room for a position on a given exchange and symbol.
-double ArbitrageEngine::remainingUsdRoom(const std::string& exchangeName,
-                                         const std::string& symbol,
-                                         const std::string& side) {
-    const auto key = posKey(exchangeName, symbol);
-    auto it = activePositionsUsd_.find(key);
-    double cur = (it == activePositionsUsd_.end()) ? 0.0 : it->second.usd;
-
-    if (side == "buy") {
+double ArbitrageEngine::remainingUsdRoom(VenueId venue, SymbolId symbol, Side side) const {
+    double cur = activePositionsUsd_[posIndex(venue, symbol)].usd;
+
+    if (side == Side::Buy) {
         if (cur >= 0.0) return std::max(0.0, maxPosUsd_ - cur);
         return maxPosUsd_ - cur; // cur < 0 => room increases
     } else {
@@ -42,11 +404,10 @@ double ArbitrageEngine::remainingUsdRoom(const std::string& exchangeName,
 }
 
 // Update and return new USD position after a trade.
-double ArbitrageEngine::applyPositionUpdate(const std::string& exchangeName, const std::string& symbol,
-                                          const std::string& side, double executedUsd) {
-    auto& pos = activePositionsUsd_[posKey(exchangeName, symbol)];
-    if (side == "buy") pos.usd += executedUsd;
-    else               pos.usd -= executedUsd;
+double ArbitrageEngine::applyPositionUpdate(VenueId venue, SymbolId symbol, Side side, double executedUsd) {
+    auto& pos = activePositionsUsd_[posIndex(venue, symbol)];
+    if (side == Side::Buy) pos.usd += executedUsd;
+    else                   pos.usd -= executedUsd;
 
     // Avoid floating point drift near zero.
     if (std::fabs(pos.usd) < 1e-6) pos.usd = 0.0;
@@ -54,103 +415,325 @@ double ArbitrageEngine::applyPositionUpdate(const std::string& exchangeName, con
     return pos.usd;
 }
 
+void ArbitrageEngine::prepare() {
+    refreshConfig();
+    for (SymbolId symbol : symbols_) {
+        SymbolState& state = symbolState_[symbol];
+        for (size_t i = 0; i < exchanges_.size(); ++i) attachBook(symbol, state, i);
+    }
+}
+
+void ArbitrageEngine::warmUp(size_t rounds) {
+    refreshConfig();
+    warmingUp_ = true;
+    for (size_t r = 0; r < rounds; ++r) {
+        for (SymbolId symbol : symbols_) checkArbitrage(symbol);
+    }
+    warmingUp_ = false;
+}
+
 void ArbitrageEngine::start() {
     Logger::info("Starting Arbitrage Engine...");
-    while (true) {
-        for (const auto& symbol : symbols_) {
-            checkArbitrage(symbol);
+
+    auto lastStatsLog = std::chrono::steady_clock::now();
+    uint32_t idleScans = 0;
+    bool firstScan = true;
+    while (!stopRequested_.load(std::memory_order_relaxed)) {
+        bool changed = scan();
+        if (firstScan) {
+            firstScan = false;
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - launch_);
+            Logger::info("Startup: first live scan " + std::to_string(ms.count()) + " ms after launch (" +
+                         std::to_string(validBooks()) + "/" + std::to_string(symbols_.size() * exchanges_.size()) +
+                         " books valid)");
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (statsLogIntervalSec_ > 0.0 &&
+            std::chrono::duration<double>(now - lastStatsLog).count() >= statsLogIntervalSec_) {
+            logSpreadStats();
+            lastStatsLog = now;
+        }
+
+        if (!busyPoll_) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(checkIntervalSec_));
+        } else if (changed) {
+            idleScans = 0;
+        } else if (pauseBackoff_) {
+            // Exponential pause backoff, capped at 64 pauses (a few microseconds).
+            uint32_t spins = 1u << std::min<uint32_t>(idleScans++, 6);
+            for (uint32_t i = 0; i < spins; ++i) RuntimeProfile::cpuRelax();
         }
-        std::this_thread::sleep_for(std::chrono::duration<double>(checkIntervalSec_));
     }
+    Logger::info("Arbitrage Engine stopped");
 }
 
-// Core arbitrage opportunity detection and execution logic.
-void ArbitrageEngine::checkArbitrage(const std::string& symbol) {
-    double bestBid = 0.0, bestAsk = std::numeric_limits<double>::max();
-    double bestBidQty = 0.0, bestAskQty = 0.0;
+bool ArbitrageEngine::scan() {
+    refreshConfig();
+    if (controlPending_.load(std::memory_order_acquire)) runControl();
+    if (pendingLegs_ > 0) collectFills();
+    bool changed = false;
+    for (SymbolId symbol : symbols_) {
+        changed |= checkArbitrage(symbol);
+    }
+    return changed;
+}
 
-    std::shared_ptr<IExchangeClient> bidExchange = nullptr, askExchange = nullptr;
+const OrderBook* ArbitrageEngine::attachBook(SymbolId symbol, SymbolState& state, size_t i) {
+    // Lock-free identity check; the locked lookup only runs when the book was replaced
+    const OrderBook* current = exchanges_[i].client->currentBook(symbol);
+    if (!current) return nullptr;
+    if (current != state.attached[i].get()) {
+        auto ob = exchanges_[i].client->getOrderBook(symbolTable().name(symbol));
+        if (!ob) return nullptr;
+        state.attached[i] = std::move(ob);
+        state.seenVersion[i] = 0; // Versions restart with the book; its first read is fresh
+    }
+    return state.attached[i].get();
+}
 
-    for (const auto& exchange : exchanges_) {
-        auto ob = exchange->getOrderBook(symbol);
+size_t ArbitrageEngine::validBooks() const {
+    size_t valid = 0;
+    for (SymbolId symbol : symbols_) {
+        for (const auto& venue : exchanges_) {
+            const OrderBook* ob = venue.client->currentBook(symbol);
+            if (!ob) continue;
+            OrderBook::TopOfBook top = ob->getTop();
+            if (top.bid > 0.0 && top.ask > 0.0) ++valid;
+        }
+    }
+    return valid;
+}
+
+// Reads every venue's book for a symbol, updates statistics and evaluates it.
+// Returns true if any book changed since the previous call.
+bool ArbitrageEngine::checkArbitrage(SymbolId symbol) {
+    SymbolState& state = symbolState_[symbol];
+    size_t n = exchanges_.size();
+
+    // Read each venue's top of book once; stats update only if some book changed.
+    std::array<OrderBook::TopOfBook, kMaxVenues> tops{};
+    std::array<bool, kMaxVenues> valid{};
+    std::array<bool, kMaxVenues> fresh{};
+    std::array<const OrderBook*, kMaxVenues> books{};
+    bool changed = false;
+    for (size_t i = 0; i < n; ++i) {
+        const OrderBook* ob = attachBook(symbol, state, i);
+        books[i] = ob;
         if (!ob) continue;
+        tops[i] = ob->getTop();
+        valid[i] = true;
+        if (tops[i].version != state.seenVersion[i]) {
+            // The engine only ever sees a book's latest version; count the ones it skipped.
+            if (state.seenVersion[i] != 0 && tops[i].version > state.seenVersion[i]) {
+                conflatedVersions_ += tops[i].version - state.seenVersion[i] - 1;
+            }
+            ++observedVersions_;
+            state.seenVersion[i] = tops[i].version;
+            fresh[i] = true;
+            changed = true;
+        }
+    }
+    if (changed) {
+        int64_t now = nowNs();
+        for (size_t i = 0; i < n; ++i) {
+            if (fresh[i] && tops[i].updateNs > 0 && !warmingUp_) {
+                // Feed-to-engine delay, dominated by wakeup jitter in sleep mode.
+                detectLatency_.record(now - tops[i].updateNs);
+            }
+            if (fresh[i] && ticks_) {
+                ticks_->recordTop(symbol, exchanges_[i].id, tops[i].bid, tops[i].bidQty, tops[i].ask, tops[i].askQty);
+            }
+        }
+        updateSpreadStats(symbol, state, tops.data(), valid.data(), now);
+    }
 
-        if (ob->getTopBidPrice() > bestBid) {
-            bestBid = ob->getTopBidPrice();
-            bestBidQty = ob->getTopBidQty();
-            bidExchange = exchange;
+    // Busy-polling evaluates only on book changes; sleep mode re-evaluates every scan.
+    if (changed || !busyPoll_ || warmingUp_) evaluate(symbol, state, tops.data(), valid.data());
+    // The merged view is for readers, so it is rebuilt after the decision, not before it
+    if (changed && state.consolidated) state.consolidated->rebuild(books.data(), venueIds_.data(), n);
+    return changed;
+}
+
+// Arbitrage opportunity detection and execution on one symbol's tops of book.
+void ArbitrageEngine::evaluate(SymbolId symbol, SymbolState& state, const OrderBook::TopOfBook* tops,
+                               const bool* valid) {
+    if (symbolPaused_[symbol].load(std::memory_order_relaxed)) return;
+    // Positions are not final while this symbol has fills in flight
+    if (symbolPending_[symbol] > 0 || activeTrades_ == kMaxOpenTrades) return;
+    if (!enter(symbol, state, tops, valid)) rebalance(symbol, tops, valid);
+}
+
+// Arbitrage opportunity detection and execution on one symbol's tops of book.
+bool ArbitrageEngine::enter(SymbolId symbol, SymbolState& state, const OrderBook::TopOfBook* tops,
+                            const bool* valid) {
+    const std::string& symbolName = symbolTable().name(symbol);
+    size_t n = exchanges_.size();
+
+    double bestBid = 0.0, bestAsk = std::numeric_limits<double>::max();
+    double bestBidQty = 0.0, bestAskQty = 0.0;
+    size_t bidIdx = n, askIdx = n;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!valid[i] || venuePaused_[exchanges_[i].id].load(std::memory_order_relaxed)) continue;
+
+        if (tops[i].bid > bestBid) {
+            bestBid = tops[i].bid;
+            bestBidQty = tops[i].bidQty;
+            bidIdx = i;
         }
 
-        if (ob->getTopAskPrice() < bestAsk) {
-            bestAsk = ob->getTopAskPrice();
-            bestAskQty = ob->getTopAskQty();
-            askExchange = exchange;
+        if (tops[i].ask > 0.0 && tops[i].ask < bestAsk) {
+            bestAsk = tops[i].ask;
+            bestAskQty = tops[i].askQty;
+            askIdx = i;
         }
     }
 
-    if (bestBid <= 0.0 || bestAsk >= bestBid) return;
+    if (bestBid <= 0.0 || bestAsk >= bestBid) return false;
 
     double spreadPct = ((bestBid - bestAsk) / bestAsk) * 100.0;
 
-    if (spreadPct > minSpreadPercent_) {
+    if (spreadPct > entryThreshold(state.pairs[askIdx * n + bidIdx])) {
 
-        std::string exchangeSell = bidExchange ? bidExchange->getExchangeName() : "Unknown";
-        std::string exchangeBuy = askExchange ? askExchange->getExchangeName() : "Unknown";
+        VenueId exchangeSell = exchanges_[bidIdx].id;
+        VenueId exchangeBuy = exchanges_[askIdx].id;
 
         // check executors exist for both exchanges
-        auto itBuyExec  = executors_.find(exchangeBuy);
-        auto itSellExec = executors_.find(exchangeSell);
-        if (itBuyExec == executors_.end() || itSellExec == executors_.end()) return;
+        ITradeExecutor* buyExec  = executors_[exchangeBuy].get();
+        ITradeExecutor* sellExec = executors_[exchangeSell].get();
+        if (!buyExec || !sellExec) return false;
 
         // Cap by orderbook quantities (base)
         double obCapQty = std::min(bestAskQty, bestBidQty);
-        if (obCapQty <= 0.0) return;
+        if (obCapQty <= 0.0) return false;
 
         // Cap by per-venue same-side max USD
-        double buyRoomUsd  = remainingUsdRoom(exchangeBuy,  symbol, "buy");
-        double sellRoomUsd = remainingUsdRoom(exchangeSell, symbol, "sell");
-        if (buyRoomUsd <= 0.0 || sellRoomUsd <= 0.0) return;
+        double buyRoomUsd  = remainingUsdRoom(exchangeBuy,  symbol, Side::Buy);
+        double sellRoomUsd = remainingUsdRoom(exchangeSell, symbol, Side::Sell);
+        if (buyRoomUsd <= 0.0 || sellRoomUsd <= 0.0) return false;
 
         double buyCapQty  = buyRoomUsd  / bestAsk;
         double sellCapQty = sellRoomUsd / bestBid;
 
         double reqQty = std::max(0.0, std::min({ obCapQty, buyCapQty, sellCapQty }));
-        if (reqQty <= 0.0) return;
 
-        Logger::info("ARB " + symbol + " | BUY " + exchangeBuy + " @" + std::to_string(bestAsk) +
-                    " | SELL " + exchangeSell + " @" + std::to_string(bestBid) +
-                    " | Spread=" + std::to_string(spreadPct) + "% | Qty=" + std::to_string(reqQty));
+        // Both legs must be the same tradable size on their venue
+        double lot = std::max(lotSize_[posIndex(exchangeBuy, symbol)], lotSize_[posIndex(exchangeSell, symbol)]);
+        if (lot > 0.0) reqQty = std::floor(reqQty / lot + 1e-9) * lot;
+        if (reqQty <= 0.0) return false;
 
-        // Execute both legs
-        Fill buyFill  = itBuyExec->second->executeTrade(symbol, "buy",  bestAsk, reqQty);
-        Fill sellFill = itSellExec->second->executeTrade(symbol, "sell", bestBid, reqQty);
+        if (warmingUp_) return false;
 
-        if (!buyFill.ok || !sellFill.ok) return;
+        const char* buyName = venueTable().name(exchangeBuy).c_str();
+        const char* sellName = venueTable().name(exchangeSell).c_str();
 
-        // Handle partials conservatively
-        double execUSD = std::min(buyFill.cost, sellFill.cost);
-        if (execUSD <= 0.0) return;
+        Logger::infof("ARB %s | BUY %s @%f | SELL %s @%f | Spread=%f%% | Qty=%f",
+                      symbolName.c_str(), buyName, bestAsk, sellName, bestBid, spreadPct, reqQty);
 
-        // Pair PnL
-        double gross = ((sellFill.price - buyFill.price) / buyFill.price ) * execUSD ;
-        // reduce fees 
-        double net  = gross - (buyFill.fee + sellFill.fee);
+        // Execute both legs with pooled orders
+        Order* buyOrder  = orders_.acquire();
+        Order* sellOrder = orders_.acquire();
+        if (!buyOrder || !sellOrder) {
+            orders_.release(buyOrder);
+            orders_.release(sellOrder);
+            Logger::error("Order pool exhausted");
+            return false;
+        }
 
-        cumulativePnl_[symbol] += net;
+        *buyOrder  = { buyOrder->id,  symbol, exchangeBuy,  Side::Buy,  bestAsk, reqQty, 0 };
+        *sellOrder = { sellOrder->id, symbol, exchangeSell, Side::Sell, bestBid, reqQty, 0 };
+
+        // Both legs pass the risk gate together or neither is sent
+        int64_t now = nowNs();
+        const Order* legs[2] = { buyOrder, sellOrder };
+        RiskReject reject = risk_.check(legs, 2, now);
+        if (reject != RiskReject::None) {
+            risk_.countReject(reject);
+            orders_.release(buyOrder);
+            orders_.release(sellOrder);
+            return false;
+        }
+        risk_.onSend(legs, 2, now);
+        buyOrder->ts = sellOrder->ts = now;
+
+        OpenTrade trade;
+        trade.kind = TradeKind::Entry;
+        trade.symbol = symbol;
+        trade.legs = 2;
+        trade.fills[0] = buyExec->executeTrade(*buyOrder);
+        trade.fills[1] = sellExec->executeTrade(*sellOrder);
+
+        orders_.release(buyOrder);
+        orders_.release(sellOrder);
+
+        // Legs that are final are booked now, the others as their fills arrive
+        track(trade);
+        return true;
+    }
+    return false;
+}
 
-        // Update positions by venue
-        double exchangeBuyPos = applyPositionUpdate(exchangeBuy,  symbol, "buy",  buyFill.cost);
-        double exchangeSellPos = applyPositionUpdate(exchangeSell, symbol, "sell", sellFill.cost);
+// Unwinds opposite inventory when the reverse spread allows (see RebalanceScheduler).
+void ArbitrageEngine::rebalance(SymbolId symbol, const OrderBook::TopOfBook* tops, const bool* valid) {
+    RebalanceScheduler::Plan plan = rebalancer_.plan(symbol, tops, valid, rebalanceMinSpread_, maxPosUsd_);
+    if (plan.usd <= 0.0) return;
 
-        Logger::info("EXEC " + symbol +
-                    " | total=$" + std::to_string(execUSD) +
-                    " | netPnL=$" + std::to_string(net) +
-                    " | cumPnL=$" + std::to_string(cumulativePnl_[symbol])+
-                    " | " + exchangeBuy + " pos=$" + std::to_string(exchangeBuyPos)+
-                    " | " + exchangeSell + " pos=$" + std::to_string(exchangeSellPos)+ "\n");
-        
+    VenueId exchangeSell = exchanges_[plan.sellIdx].id;
+    VenueId exchangeBuy = exchanges_[plan.buyIdx].id;
+    if (venuePaused_[exchangeSell].load(std::memory_order_relaxed) ||
+        venuePaused_[exchangeBuy].load(std::memory_order_relaxed)) {
+        return;
+    }
+    ITradeExecutor* sellExec = executors_[exchangeSell].get();
+    ITradeExecutor* buyExec = executors_[exchangeBuy].get();
+    if (!buyExec || !sellExec) return;
+
+    const OrderBook::TopOfBook& sellTop = tops[plan.sellIdx];
+    const OrderBook::TopOfBook& buyTop = tops[plan.buyIdx];
+    double qty = std::min({ plan.usd / sellTop.bid, sellTop.bidQty, buyTop.askQty });
+    double lot = std::max(lotSize_[posIndex(exchangeBuy, symbol)], lotSize_[posIndex(exchangeSell, symbol)]);
+    if (lot > 0.0) qty = std::floor(qty / lot + 1e-9) * lot;
+    if (qty <= 0.0 || warmingUp_) return;
+
+    const char* symbolName = symbolTable().name(symbol).c_str();
+    const char* sellName = venueTable().name(exchangeSell).c_str();
+    const char* buyName = venueTable().name(exchangeBuy).c_str();
+    Logger::infof("REBAL %s | SELL %s @%f | BUY %s @%f | Spread=%f%% | Qty=%f",
+                  symbolName, sellName, sellTop.bid, buyName, buyTop.ask, plan.spreadPct, qty);
+
+    Order* sellOrder = orders_.acquire();
+    Order* buyOrder = orders_.acquire();
+    if (!buyOrder || !sellOrder) {
+        orders_.release(buyOrder);
+        orders_.release(sellOrder);
+        Logger::error("Order pool exhausted");
+        return;
     }
-    else if (spreadPct > rebalanceMinSpread_) {
-        // TODO: Rebalance logic if spread is above rebalanceMinSpread
+    *sellOrder = { sellOrder->id, symbol, exchangeSell, Side::Sell, sellTop.bid, qty, 0 };
+    *buyOrder  = { buyOrder->id,  symbol, exchangeBuy,  Side::Buy,  buyTop.ask,  qty, 0 };
+
+    // Unwinds shrink exposure, but rate limits, the kill switch and duplicates still apply
+    int64_t now = nowNs();
+    const Order* legs[2] = { sellOrder, buyOrder };
+    RiskReject reject = risk_.check(legs, 2, now);
+    if (reject != RiskReject::None) {
+        risk_.countReject(reject);
+        orders_.release(buyOrder);
+        orders_.release(sellOrder);
+        return;
     }
+    risk_.onSend(legs, 2, now);
+    sellOrder->ts = buyOrder->ts = now;
+
+    OpenTrade trade;
+    trade.kind = TradeKind::Unwind;
+    trade.symbol = symbol;
+    trade.legs = 2;
+    trade.fills[1] = sellExec->executeTrade(*sellOrder);
+    trade.fills[0] = buyExec->executeTrade(*buyOrder);
+
+    orders_.release(buyOrder);
+    orders_.release(sellOrder);
+    track(trade);
 }
\ No newline at end of file
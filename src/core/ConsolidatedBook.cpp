@@ -0,0 +1,126 @@
+#include "core/ConsolidatedBook.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<ConsolidatedBook::Snapshot>, "Snapshot is copied with memcpy");
+
+ConsolidatedBook::ConsolidatedBook() {
+    // Sized once so rebuilds on the engine thread never allocate
+    for (auto& levels : bidScratch_) levels.reserve(kSnapshotLevels);
+    for (auto& levels : askScratch_) levels.reserve(kSnapshotLevels);
+}
+
+void ConsolidatedBook::setFeePercent(VenueId venue, double feePct) {
+    feeMult_[venue] = feePct / 100.0;
+}
+
+size_t ConsolidatedBook::merge(const std::array<std::vector<OrderBook::PriceLevel>, kMaxVenues>& sides,
+                               const VenueId* venues, size_t count, bool bids,
+                               std::array<Level, kSnapshotLevels>& out) const {
+    // k-way merge of lists already sorted best first; a venue's levels in the merged
+    // top all lie within its own top kSnapshotLevels.
+    std::array<size_t, kMaxVenues> next{};
+    size_t n = 0;
+    while (true) {
+        size_t best = count;
+        double bestPrice = 0.0;
+        for (size_t v = 0; v < count; ++v) {
+            if (next[v] >= sides[v].size()) continue;
+            double fee = feeMult_[venues[v]];
+            double price = sides[v][next[v]].first * (bids ? 1.0 - fee : 1.0 + fee);
+            if (best == count || (bids ? price > bestPrice : price < bestPrice)) {
+                best = v;
+                bestPrice = price;
+            }
+        }
+        if (best == count) break;
+
+        if (n == 0 || out[n - 1].price != bestPrice) {
+            if (n == kSnapshotLevels) break;
+            out[n] = Level{};
+            out[n].price = bestPrice;
+            ++n;
+        }
+        double qty = sides[best][next[best]++].second;
+        out[n - 1].venueQty[venues[best]] += qty;
+        out[n - 1].qty += qty;
+    }
+    return n;
+}
+
+void ConsolidatedBook::rebuild(const OrderBook* const* books, const VenueId* venues, size_t count) {
+    for (size_t v = 0; v < count; ++v) {
+        if (books[v]) {
+            books[v]->copyTopNBids(kSnapshotLevels, bidScratch_[v]);
+            books[v]->copyTopNAsks(kSnapshotLevels, askScratch_[v]);
+        } else {
+            bidScratch_[v].clear();
+            askScratch_[v].clear();
+        }
+    }
+    staging_.bidCount = merge(bidScratch_, venues, count, true, staging_.bids);
+    staging_.askCount = merge(askScratch_, venues, count, false, staging_.asks);
+
+    // A change below the merged top leaves readers nothing new to copy
+    if (staging_.version > 0 && staging_.bidCount == published_.bidCount &&
+        staging_.askCount == published_.askCount &&
+        std::memcmp(staging_.bids.data(), published_.bids.data(), staging_.bidCount * sizeof(Level)) == 0 &&
+        std::memcmp(staging_.asks.data(), published_.asks.data(), staging_.askCount * sizeof(Level)) == 0) {
+        return;
+    }
+    staging_.version++;
+    publish();
+}
+
+void ConsolidatedBook::publish() {
+    // Seqlock write: readers retry if they overlap it.
+    uint64_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(static_cast<void*>(&published_), &staging_, sizeof(Snapshot));
+    seq_.store(seq + 2, std::memory_order_release);
+}
+
+void ConsolidatedBook::read(Snapshot& out) const {
+    while (true) {
+        uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) continue; // Write in progress
+        std::memcpy(static_cast<void*>(&out), &published_, sizeof(Snapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) == before) return;
+    }
+}
+
+ConsolidatedBook::CrossedRegion ConsolidatedBook::crossedRegion(const Snapshot& snap) {
+    CrossedRegion region;
+    size_t b = 0, a = 0;
+    double bidLeft = snap.bidCount ? snap.bids[0].qty : 0.0;
+    double askLeft = snap.askCount ? snap.asks[0].qty : 0.0;
+
+    while (b < snap.bidCount && a < snap.askCount && snap.bids[b].price > snap.asks[a].price) {
+        double take = std::min(bidLeft, askLeft);
+        region.qty += take;
+        region.sellProceeds += take * snap.bids[b].price;
+        region.buyCost += take * snap.asks[a].price;
+        region.bidLevels = b + 1;
+        region.askLevels = a + 1;
+
+        bidLeft -= take;
+        askLeft -= take;
+        if (bidLeft <= 0.0 && ++b < snap.bidCount) bidLeft = snap.bids[b].qty;
+        if (askLeft <= 0.0 && ++a < snap.askCount) askLeft = snap.asks[a].qty;
+    }
+    return region;
+}
+
+double ConsolidatedBook::liquidity(const Snapshot& snap, Side side, double limitPrice) {
+    double qty = 0.0;
+    if (side == Side::Buy) {
+        for (size_t i = 0; i < snap.askCount && snap.asks[i].price <= limitPrice; ++i) qty += snap.asks[i].qty;
+    } else {
+        for (size_t i = 0; i < snap.bidCount && snap.bids[i].price >= limitPrice; ++i) qty += snap.bids[i].qty;
+    }
+    return qty;
+}
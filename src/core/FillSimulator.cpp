@@ -0,0 +1,66 @@
+#include "core/FillSimulator.hpp"
+
+#include <algorithm>
+
+FillSimulator::FillSimulator(size_t depthLevels)
+    : depthLevels_(depthLevels) {
+    levels_.reserve(depthLevels_);
+}
+
+SimulatedFill FillSimulator::match(SymbolId symbol, const OrderBook& book, Side side, double limitPrice, double qty) {
+    SimulatedFill result;
+    if (qty <= 0.0) return result;
+
+    // A buy takes asks, a sell takes bids.
+    bool isBuy = (side == Side::Buy);
+    if (isBuy) book.copyTopNAsks(depthLevels_, levels_);
+    else       book.copyTopNBids(depthLevels_, levels_);
+
+    if (symbol >= states_.size()) {
+        states_.resize(symbol + 1);
+    }
+    ConsumedLevels& consumed = isBuy ? states_[symbol].asks : states_[symbol].bids;
+    if (consumed.capacity() == 0) consumed.reserve(2 * depthLevels_ + 1);
+
+    double remaining = qty;
+    double notional = 0.0;
+
+    for (const auto& [price, levelQty] : levels_) {
+        if (remaining <= 0.0) break;
+        if (isBuy ? price > limitPrice : price < limitPrice) break;
+
+        auto it = std::find_if(consumed.begin(), consumed.end(),
+                               [price = price](const Consumed& c) { return c.price == price; });
+        if (it != consumed.end() && it->levelQty != levelQty) {
+            // Venue refreshed the level; our consumption no longer applies
+            it->levelQty = levelQty;
+            it->taken = 0.0;
+        }
+
+        double available = levelQty - (it != consumed.end() ? it->taken : 0.0);
+        if (available <= 0.0) continue;
+
+        double take = std::min(available, remaining);
+        if (it == consumed.end()) {
+            if (consumed.size() == consumed.capacity()) prune(consumed);
+            consumed.push_back({ price, levelQty, take });
+        } else {
+            it->taken += take;
+        }
+
+        notional += take * price;
+        remaining -= take;
+        ++result.levels;
+    }
+
+    result.qty = qty - remaining;
+    result.avgPrice = (result.qty > 0.0) ? notional / result.qty : 0.0;
+    return result;
+}
+
+void FillSimulator::prune(ConsumedLevels& consumed) const {
+    consumed.erase(std::remove_if(consumed.begin(), consumed.end(), [&](const Consumed& c) {
+        return std::none_of(levels_.begin(), levels_.end(),
+                            [&](const OrderBook::PriceLevel& l) { return l.first == c.price; });
+    }), consumed.end());
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "core/FramePipeline.hpp"
+#include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    constexpr size_t kFrameReserve = 4096; // Initial buffer size; depth5/orderbook.50 frames fit
+}
+
+FramePipeline::Channel::Channel(std::string name, Handler handler, GapHandler onGap, size_t depth, bool prefault)
+    : name_(std::move(name)), handler_(std::move(handler)), onGap_(std::move(onGap)),
+      storage_(std::make_unique<Frame[]>(depth)), filled_(depth), free_(depth) {
+    for (size_t i = 0; i < depth; ++i) {
+        if (prefault) {
+            // Write the buffer once so its pages are mapped before the first frame; clear() keeps capacity
+            storage_[i].data.resize(kFrameReserve);
+            storage_[i].data.clear();
+        } else {
+            storage_[i].data.reserve(kFrameReserve);
+        }
+        free_.tryPush(&storage_[i]);
+    }
+}
+
+bool FramePipeline::Channel::push(std::string_view frame) {
+    int64_t recvNs = nowNs();
+    Frame* buf = nullptr;
+    if (closed_.load(std::memory_order_relaxed) || !free_.tryPop(buf)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        gap_.store(true, std::memory_order_release);
+        return false;
+    }
+
+    buf->recvNs = recvNs;
+    buf->data.assign(frame.data(), frame.size()); // Reuses capacity once warmed up
+    // Every buffer is either free or queued, so filled_ (same capacity) cannot be full here.
+    filled_.tryPush(buf);
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+FramePipeline::FramePipeline(PipelineSettings settings)
+    : settings_(std::move(settings)) {
+    settings_.builderThreads = std::max<size_t>(1, settings_.builderThreads);
+    settings_.queueDepth = std::max<size_t>(2, settings_.queueDepth);
+    for (size_t i = 0; i < settings_.builderThreads; ++i) {
+        builders_.push_back(std::make_unique<Builder>());
+        builders_.back()->batch.reserve(settings_.queueDepth);
+    }
+}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+std::shared_ptr<FramePipeline::Channel> FramePipeline::addChannel(std::string name, Handler handler, GapHandler onGap) {
+    std::shared_ptr<Channel> channel(new Channel(std::move(name), std::move(handler), std::move(onGap),
+                                                 settings_.queueDepth, settings_.prefault));
+
+    Builder& b = *builders_[nextBuilder_.fetch_add(1, std::memory_order_relaxed) % builders_.size()];
+    {
+        std::lock_guard<std::mutex> lock(b.mutex);
+        b.channels.push_back(channel);
+    }
+    b.generation.fetch_add(1, std::memory_order_release);
+    return channel;
+}
+
+void FramePipeline::removeChannel(const std::shared_ptr<Channel>& channel) {
+    if (!channel) return;
+    channel->closed_.store(true, std::memory_order_relaxed);
+
+    for (auto& b : builders_) {
+        std::lock_guard<std::mutex> lock(b->mutex);
+        auto it = std::find(b->channels.begin(), b->channels.end(), channel);
+        if (it != b->channels.end()) {
+            b->channels.erase(it);
+            b->generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+void FramePipeline::start() {
+    if (running_.exchange(true)) return;
+
+    for (size_t i = 0; i < builders_.size(); ++i) {
+        builders_[i]->thread = std::thread([this, i]() { run(i); });
+    }
+    Logger::info("Frame pipeline started: " + std::to_string(builders_.size()) + " book builder(s), queue depth " +
+                 std::to_string(settings_.queueDepth));
+}
+
+void FramePipeline::stop() {
+    if (!running_.exchange(false)) return;
+    for (auto& b : builders_) {
+        if (b->thread.joinable()) b->thread.join();
+    }
+}
+
+FramePipeline::Stats FramePipeline::stats() const {
+    Stats s;
+    for (const auto& b : builders_) {
+        std::lock_guard<std::mutex> lock(b->mutex);
+        for (const auto& ch : b->channels) {
+            size_t depth = ch->filled_.size();
+            ++s.channels;
+            s.depth += depth;
+            s.maxDepth = std::max(s.maxDepth, depth);
+            s.pushed += ch->pushed_.load(std::memory_order_relaxed);
+            s.dropped += ch->dropped_.load(std::memory_order_relaxed);
+            s.processed += ch->processed_.load(std::memory_order_relaxed);
+            s.conflated += ch->conflated_.load(std::memory_order_relaxed);
+        }
+    }
+    return s;
+}
+
+void FramePipeline::logStats(size_t index, Builder& builder) {
+    if (index == 0) {
+        Stats s = stats();
+        Logger::infof("[PIPELINE] channels=%zu depth=%zu maxDepth=%zu pushed=%llu processed=%llu conflated=%llu "
+                      "dropped=%llu", s.channels, s.depth, s.maxDepth, static_cast<unsigned long long>(s.pushed),
+                      static_cast<unsigned long long>(s.processed), static_cast<unsigned long long>(s.conflated),
+                      static_cast<unsigned long long>(s.dropped));
+    }
+
+    const LatencyHistogram& h = builder.queueLatency;
+    if (h.count() > 0) {
+        Logger::infof("[PIPELINE] builder=%zu queue latency us: n=%llu p50=%.1f p99=%.1f p999=%.1f max=%.1f", index,
+                      static_cast<unsigned long long>(h.count()), h.percentile(0.50) / 1e3, h.percentile(0.99) / 1e3,
+                      h.percentile(0.999) / 1e3, h.max() / 1e3);
+    }
+    builder.queueLatency.reset();
+}
+
+void FramePipeline::run(size_t index) {
+    Builder& self = *builders_[index];
+
+    if (!settings_.builderCores.empty()) {
+        int core = settings_.builderCores[index % settings_.builderCores.size()];
+        if (RuntimeProfile::pinCurrentThread(core)) {
+            Logger::info("Runtime: book builder " + std::to_string(index) + " pinned to core " + std::to_string(core));
+        }
+    } else {
+        RuntimeProfile::enterBackgroundThread();
+    }
+
+    std::vector<std::shared_ptr<Channel>> channels; // Private copy, refreshed when the set changes
+    uint64_t seenGeneration = ~uint64_t(0);
+
+    const int64_t logIntervalNs = static_cast<int64_t>(settings_.statsLogIntervalSec * 1e9);
+    int64_t nextLogNs = nowNs() + logIntervalNs;
+    unsigned idle = 0;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        uint64_t gen = self.generation.load(std::memory_order_acquire);
+        if (gen != seenGeneration) {
+            std::lock_guard<std::mutex> lock(self.mutex);
+            channels = self.channels;
+            seenGeneration = gen;
+        }
+
+        bool didWork = false;
+        for (const auto& ch : channels) {
+            // Take everything queued on the channel (at most queueDepth frames, so one busy
+            // symbol cannot starve the rest) and hand it over as one conflated batch.
+            auto& batch = self.batch;
+            Channel::Frame* frame = nullptr;
+            while (batch.size() < settings_.queueDepth && ch->filled_.tryPop(frame)) batch.push_back(frame);
+            // Checked after taking the batch: a drop flagged by now came after the frames before it
+            bool gap = ch->gap_.load(std::memory_order_relaxed) && ch->gap_.exchange(false, std::memory_order_acquire);
+            if (batch.empty() && !gap) continue;
+            didWork = true;
+
+            if (!ch->closed_.load(std::memory_order_relaxed)) {
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    try {
+                        ch->handler_(batch[i]->data, batch[i]->recvNs, i + 1 == batch.size());
+                    } catch (const std::exception& ex) {
+                        Logger::error("[PIPELINE] " + ch->name_ + " handler error: " + ex.what());
+                    }
+                }
+                if (gap && ch->onGap_) {
+                    try {
+                        ch->onGap_();
+                    } catch (const std::exception& ex) {
+                        Logger::error("[PIPELINE] " + ch->name_ + " gap handler error: " + ex.what());
+                    }
+                }
+                if (!batch.empty()) {
+                    int64_t appliedNs = nowNs();
+                    for (Channel::Frame* f : batch) self.queueLatency.record(appliedNs - f->recvNs);
+                    ch->processed_.fetch_add(batch.size(), std::memory_order_relaxed);
+                    ch->conflated_.fetch_add(batch.size() - 1, std::memory_order_relaxed);
+                }
+            }
+
+            for (Channel::Frame* f : batch) ch->free_.tryPush(f);
+            batch.clear();
+        }
+
+        if (logIntervalNs > 0) {
+            int64_t now = nowNs();
+            if (now >= nextLogNs) {
+                logStats(index, self);
+                nextLogNs = now + logIntervalNs;
+            }
+        }
+
+        if (didWork) {
+            idle = 0;
+        } else if (settings_.busyPoll) {
+            for (unsigned i = 0, n = 1u << std::min(idle++, 6u); i < n; ++i) RuntimeProfile::cpuRelax();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
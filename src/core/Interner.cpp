@@ -0,0 +1,40 @@
+#include "core/Interner.hpp"
+
+#include <stdexcept>
+
+Interner::Interner(size_t capacity)
+    : capacity_(capacity), names_(std::make_unique<std::string[]>(capacity)) {
+    ids_.reserve(capacity);
+}
+
+uint32_t Interner::intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(std::string(name));
+    if (it != ids_.end()) return it->second;
+
+    size_t id = size_.load(std::memory_order_relaxed);
+    if (id >= capacity_) {
+        throw std::length_error("Interner capacity exhausted at: " + std::string(name));
+    }
+
+    names_[id] = std::string(name);
+    ids_.emplace(names_[id], static_cast<uint32_t>(id));
+    size_.store(id + 1, std::memory_order_release); // Publish the name before the id is visible
+    return static_cast<uint32_t>(id);
+}
+
+int64_t Interner::find(std::string_view name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(std::string(name));
+    return it == ids_.end() ? -1 : static_cast<int64_t>(it->second);
+}
+
+Interner& symbolTable() {
+    static Interner table(kMaxSymbols);
+    return table;
+}
+
+Interner& venueTable() {
+    static Interner table(kMaxVenues);
+    return table;
+}
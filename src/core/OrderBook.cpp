@@ -1,23 +1,67 @@
 #include "core/OrderBook.hpp"
 
+#include <chrono>
+
 OrderBook::OrderBook() {}
 
+void OrderBook::touch() {
+    updateNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    version_.fetch_add(1, std::memory_order_release);
+}
+
 void OrderBook::updateBid(double price, double qty) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (qty == 0.0) bids_.erase(price); // Remove level if qty is zero
     else bids_[price] = qty;            // Insert or update bid
+    touch();
 }
 
 void OrderBook::updateAsk(double price, double qty) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (qty == 0.0) asks_.erase(price); // Remove level if qty is zero
     else asks_[price] = qty;            // Insert or update ask
+    touch();
+}
+
+void OrderBook::apply(const std::vector<PriceLevel>& bids, const std::vector<PriceLevel>& asks, bool snapshot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (snapshot) {
+        bids_.clear();
+        asks_.clear();
+    }
+    for (const auto& [price, qty] : bids) {
+        if (qty == 0.0) bids_.erase(price);
+        else bids_[price] = qty;
+    }
+    for (const auto& [price, qty] : asks) {
+        if (qty == 0.0) asks_.erase(price);
+        else asks_[price] = qty;
+    }
+    touch();
 }
 
 void OrderBook::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     bids_.clear();
     asks_.clear();
+    touch();
+}
+
+OrderBook::TopOfBook OrderBook::getTop() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TopOfBook top;
+    if (!bids_.empty()) {
+        top.bid = bids_.begin()->first;
+        top.bidQty = bids_.begin()->second;
+    }
+    if (!asks_.empty()) {
+        top.ask = asks_.rbegin()->first;   // Lowest ask
+        top.askQty = asks_.rbegin()->second;
+    }
+    top.version = version_.load(std::memory_order_relaxed);
+    top.updateNs = updateNs_;
+    return top;
 }
 
 std::vector<OrderBook::PriceLevel> OrderBook::getTopNBids(size_t n) const {
@@ -41,6 +85,25 @@ std::vector<OrderBook::PriceLevel> OrderBook::getTopNAsks(size_t n) const {
     return result;
 }
 
+void OrderBook::copyTopNBids(size_t n, std::vector<PriceLevel>& out) const {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [price, qty] : bids_) {
+        if (out.size() >= n) break;
+        if (qty > 0.0) out.emplace_back(price, qty);
+    }
+}
+
+void OrderBook::copyTopNAsks(size_t n, std::vector<PriceLevel>& out) const {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Asks are stored descending; lowest prices are at the end
+    for (auto it = asks_.rbegin(); it != asks_.rend(); ++it) {
+        if (out.size() >= n) break;
+        if (it->second > 0.0) out.emplace_back(it->first, it->second);
+    }
+}
+
 double OrderBook::getTopBidPrice() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return bids_.empty() ? 0.0 : bids_.begin()->first;
@@ -48,7 +111,7 @@ double OrderBook::getTopBidPrice() const {
 
 double OrderBook::getTopAskPrice() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return asks_.empty() ? 0.0 : asks_.begin()->first;
+    return asks_.empty() ? 0.0 : asks_.rbegin()->first; // Lowest ask
 }
 
 double OrderBook::getTopBidQty() const {
@@ -58,5 +121,5 @@ double OrderBook::getTopBidQty() const {
 
 double OrderBook::getTopAskQty() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return asks_.empty() ? 0.0 : asks_.begin()->second;
+    return asks_.empty() ? 0.0 : asks_.rbegin()->second;
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "core/OrderPool.hpp"
+
+OrderPool::OrderPool(size_t capacity)
+    : orders_(capacity) {
+    freeList_.reserve(capacity);
+    for (auto it = orders_.rbegin(); it != orders_.rend(); ++it) {
+        freeList_.push_back(&*it);
+    }
+}
+
+Order* OrderPool::acquire() {
+    if (freeList_.empty()) return nullptr;
+    Order* order = freeList_.back();
+    freeList_.pop_back();
+    *order = Order{};
+    order->id = nextId_++;
+    return order;
+}
+
+void OrderPool::release(Order* order) {
+    if (order) freeList_.push_back(order);
+}
@@ -1,39 +1,135 @@
 #include "core/PaperTrader.hpp"
+#include "core/Interner.hpp"
 #include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
 #include <chrono>
+#include <cmath>
+#include <thread>
 
 static int64_t now_ms() {
     using namespace std::chrono;
     return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
 }
 
+static int64_t now_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
 PaperTrader::PaperTrader(std::string exchangeName, double feePercent)
-    : exchange_(std::move(exchangeName)), feePct_(feePercent) {}
-
-Fill PaperTrader::executeTrade(
-    const std::string& symbol,
-    const std::string& side,
-    double price,
-    double maxQty
-) {
+    : exchange_(std::move(exchangeName)),
+      venue_(static_cast<VenueId>(venueTable().intern(exchange_))),
+      feePct_(feePercent) {}
+
+PaperTrader::~PaperTrader() {
+    if (running_.exchange(false) && matcher_.joinable()) matcher_.join();
+}
+
+void PaperTrader::enableDepthSimulation(std::shared_ptr<IExchangeClient> venue, const PaperSimConfig& cfg) {
+    sim_ = cfg;
+    sim_.enabled = true;
+    books_ = std::move(venue);
+    simulator_ = std::make_unique<FillSimulator>(sim_.depthLevels);
+    Logger::info("[PAPER/" + exchange_ + "] depth simulation on: latency=" + std::to_string(sim_.latencyMs) +
+                 "ms depth=" + std::to_string(sim_.depthLevels) +
+                 " slippage=" + std::to_string(sim_.slippagePct) + "%");
+
+    // The simulator then belongs to the matcher thread
+    if (sim_.latencyMs > 0.0 && !running_.exchange(true)) {
+        matcher_ = std::thread([this]() { runMatcher(); });
+    }
+}
+
+Fill PaperTrader::executeTrade(const Order& order) {
     Fill f;
-    f.exchange  = exchange_;
-    f.symbol = symbol;
-    f.side   = side;
-    f.price  = price;
-    f.qty    = maxQty; 
+    f.orderId = order.id;
+    f.symbol  = order.symbol;
+    f.venue   = venue_;
+    f.side    = order.side;
+    f.price   = order.price;
+    f.qty     = order.qty;
+
+    if (running_.load(std::memory_order_relaxed)) {
+        // The order reaches the book after the latency; the scan loop carries on meanwhile.
+        f.qty = 0.0;
+        int64_t latencyNs = static_cast<int64_t>(sim_.latencyMs * 1e6);
+        int64_t sentNs = order.ts != 0 ? order.ts : now_ns();
+        if (inFlight_.tryPush({ order, sentNs, sentNs + latencyNs })) {
+            f.pending = true;
+            return f;
+        }
+        Logger::infof("[PAPER/%s] rejected %s %s: too many orders in flight", exchange_.c_str(),
+                      sideName(order.side), symbolTable().name(order.symbol).c_str());
+        return f;
+    }
+
+    if (simulator_) match(order, f);
+    finish(order, f);
+    return f;
+}
+
+size_t PaperTrader::pollFills(Fill* out, size_t max) {
+    size_t n = 0;
+    while (n < max && done_.tryPop(out[n])) ++n;
+    return n;
+}
+
+void PaperTrader::match(const Order& order, Fill& f) {
+    f.qty = 0.0;
+    auto ob = books_->getOrderBook(symbolTable().name(order.symbol));
+    if (ob) {
+        double tol = sim_.slippagePct / 100.0;
+        double limit = (order.side == Side::Buy) ? order.price * (1.0 + tol) : order.price * (1.0 - tol);
+        SimulatedFill sf = simulator_->match(order.symbol, *ob, order.side, limit, order.qty);
+        f.qty = sf.qty;
+        f.price = sf.avgPrice;
+    }
+    f.ackLatencyUs = static_cast<int64_t>(sim_.latencyMs * 1000.0);
+}
+
+void PaperTrader::finish(const Order& order, Fill& f) {
     f.cost   = std::round(f.qty * f.price * 100.0) / 100.0; // usd amount Round to 2 decimals
-    f.fee    = (price * f.qty) * (feePct_ / 100.0);
+    f.fee    = (f.price * f.qty) * (feePct_ / 100.0);
     f.ts     = now_ms();
     f.ok     = (f.qty > 0.0 && f.price > 0.0);
+    f.pending = false;
 
+    const std::string& symbol = symbolTable().name(order.symbol);
     if (f.ok) {
-        Logger::info("[PAPER/" + exchange_ + "] " + side + " " + symbol +
-                     " qty=" + std::to_string(f.qty) +
-                     " @ " + std::to_string(f.price) +
-                     " fee=" + std::to_string(f.fee));
+        Logger::infof("[PAPER/%s] %s %s qty=%f/%f @ %f fee=%f", exchange_.c_str(), sideName(order.side),
+                      symbol.c_str(), f.qty, order.qty, f.price, f.fee);
     } else {
-        Logger::info("[PAPER/" + exchange_ + "] rejected " + side + " " + symbol);
+        Logger::infof("[PAPER/%s] rejected %s %s", exchange_.c_str(), sideName(order.side), symbol.c_str());
     }
-    return f;
-}
\ No newline at end of file
+}
+
+void PaperTrader::runMatcher() {
+    RuntimeProfile::enterBackgroundThread();
+
+    InFlight next;
+    while (running_.load(std::memory_order_relaxed)) {
+        if (!inFlight_.tryPop(next)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            continue;
+        }
+
+        // Orders share one latency, so they arrive in the order they were sent.
+        int64_t waitNs = next.dueNs - now_ns();
+        if (waitNs > 0) std::this_thread::sleep_for(std::chrono::nanoseconds(waitNs));
+
+        Fill f;
+        f.orderId = next.order.id;
+        f.symbol  = next.order.symbol;
+        f.venue   = venue_;
+        f.side    = next.order.side;
+        f.price   = next.order.price;
+        match(next.order, f);
+        f.ackLatencyUs = (now_ns() - next.sentNs) / 1000;
+        finish(next.order, f);
+
+        // done_ is as deep as inFlight_, so it only fills up while the engine is not polling
+        while (!done_.tryPush(f) && running_.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
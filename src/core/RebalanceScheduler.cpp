@@ -0,0 +1,43 @@
+#include "core/RebalanceScheduler.hpp"
+
+#include <algorithm>
+
+RebalanceScheduler::RebalanceScheduler()
+    : inventory_(kMaxSymbols) {}
+
+void RebalanceScheduler::onPositions(SymbolId symbol, const double* usd, size_t venueCount) {
+    Inventory inv;
+    for (size_t i = 0; i < venueCount; ++i) {
+        if (usd[i] > inv.longUsd) {
+            inv.longUsd = usd[i];
+            inv.longIdx = static_cast<int>(i);
+        } else if (-usd[i] > inv.shortUsd) {
+            inv.shortUsd = -usd[i];
+            inv.shortIdx = static_cast<int>(i);
+        }
+    }
+    inventory_[symbol] = inv;
+}
+
+RebalanceScheduler::Plan RebalanceScheduler::plan(SymbolId symbol, const OrderBook::TopOfBook* tops,
+                                                  const bool* valid, double minSpreadPct, double maxPosUsd) const {
+    const Inventory& inv = inventory_[symbol];
+    if (inv.longIdx < 0 || inv.shortIdx < 0) return {};
+
+    const OrderBook::TopOfBook& sellTop = tops[inv.longIdx];
+    const OrderBook::TopOfBook& buyTop = tops[inv.shortIdx];
+    if (!valid[inv.longIdx] || !valid[inv.shortIdx] || sellTop.bid <= 0.0 || buyTop.ask <= 0.0) return {};
+
+    double spreadPct = ((sellTop.bid - buyTop.ask) / buyTop.ask) * 100.0;
+    if (spreadPct <= minSpreadPct) return {};
+
+    double usd = std::min(inv.longUsd, inv.shortUsd);
+    if (settings_.maxUnwindUsd > 0.0) usd = std::min(usd, settings_.maxUnwindUsd);
+
+    // Each unwind costs two orders: let small ones accumulate unless the inventory is blocking entries
+    bool blocking = maxPosUsd - inv.longUsd < settings_.minUnwindUsd ||
+                    maxPosUsd - inv.shortUsd < settings_.minUnwindUsd;
+    if (usd < settings_.minUnwindUsd && !blocking) return {};
+
+    return { static_cast<size_t>(inv.longIdx), static_cast<size_t>(inv.shortIdx), usd, spreadPct };
+}
@@ -0,0 +1,164 @@
+#include "core/RiskGate.hpp"
+#include "core/Interner.hpp"
+#include "common/Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+const char* riskRejectName(RiskReject reason) {
+    switch (reason) {
+        case RiskReject::None:          return "none";
+        case RiskReject::KillSwitch:    return "kill_switch";
+        case RiskReject::RateLimit:     return "rate_limit";
+        case RiskReject::OrderNotional: return "order_notional";
+        case RiskReject::SymbolGross:   return "symbol_gross";
+        case RiskReject::SymbolNet:     return "symbol_net";
+        case RiskReject::GlobalGross:   return "global_gross";
+        case RiskReject::GlobalNet:     return "global_net";
+        case RiskReject::Duplicate:     return "duplicate";
+        case RiskReject::SelfTrade:     return "self_trade";
+        case RiskReject::Count:         break;
+    }
+    return "unknown";
+}
+
+RiskGate::RiskGate()
+    : positionUsd_(size_t(kMaxSymbols) * kMaxVenues, 0.0),
+      symbolGross_(kMaxSymbols, 0.0),
+      symbolNet_(kMaxSymbols, 0.0),
+      lastOrder_(size_t(kMaxSymbols) * kMaxVenues * 2) {}
+
+void RiskGate::configure(const RiskLimits& limits) {
+    limits_ = limits;
+    duplicateWindowNs_ = static_cast<int64_t>(limits.duplicateWindowMs * 1e6);
+
+    for (size_t v = 0; v < buckets_.size(); ++v) {
+        RateLimit rate = limits.rate;
+        if (v < venueTable().size()) {
+            auto it = limits.venueRates.find(venueTable().name(static_cast<uint32_t>(v)));
+            if (it != limits.venueRates.end()) rate = it->second;
+        }
+
+        Bucket& b = buckets_[v];
+        double capacity = rate.burst > 0.0 ? rate.burst : rate.ordersPerSec;
+        if (b.ratePerNs == 0.0) b.tokens = capacity; // Newly limited: start full
+        b.ratePerNs = rate.ordersPerSec / 1e9;
+        b.capacity = std::max(capacity, 1.0);
+        b.tokens = std::min(b.tokens, b.capacity);
+    }
+
+    if (limits.maxLossUsd > 0.0 && !killed_ && pnlUsd_ <= -limits.maxLossUsd) {
+        killed_ = true;
+        Logger::error("RISK kill switch: cumulative PnL $" + std::to_string(pnlUsd_) + " is past the loss limit");
+    }
+}
+
+double RiskGate::Bucket::available(int64_t nowNs) const {
+    if (lastNs != 0 && nowNs > lastNs) tokens = std::min(capacity, tokens + (nowNs - lastNs) * ratePerNs);
+    lastNs = nowNs;
+    return tokens;
+}
+
+RiskReject RiskGate::check(const Order* const* orders, size_t count, int64_t nowNs) const {
+    if (killed_) return RiskReject::KillSwitch;
+
+    double grossDelta = 0.0, netDelta = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const Order& o = *orders[i];
+        double usd = o.price * o.qty;
+
+        if (limits_.maxOrderUsd > 0.0 && usd > limits_.maxOrderUsd) return RiskReject::OrderNotional;
+
+        // Orders in one group on the same venue and symbol would trade against each other
+        size_t sameVenue = 1;
+        for (size_t j = 0; j < i; ++j) {
+            if (orders[j]->venue != o.venue) continue;
+            ++sameVenue;
+            if (orders[j]->symbol == o.symbol && orders[j]->side != o.side) return RiskReject::SelfTrade;
+        }
+
+        const Bucket& bucket = buckets_[o.venue];
+        if (bucket.ratePerNs > 0.0 && bucket.available(nowNs) < static_cast<double>(sameVenue)) {
+            return RiskReject::RateLimit;
+        }
+
+        if (duplicateWindowNs_ > 0) {
+            const LastOrder& last = lastOrder_[lastIndex(o)];
+            if (last.sentNs != 0 && nowNs - last.sentNs < duplicateWindowNs_ &&
+                last.price == o.price && last.qty == o.qty) {
+                return RiskReject::Duplicate;
+            }
+        }
+
+        double pos = positionUsd_[posIndex(o.venue, o.symbol)];
+        double delta = signedUsd(o.side, usd);
+        double legGross = std::fabs(pos + delta) - std::fabs(pos);
+
+        // Symbol limits see every leg of the group on the same symbol
+        double symGross = symbolGross_[o.symbol] + legGross;
+        double symNet = symbolNet_[o.symbol] + delta;
+        for (size_t j = 0; j < count; ++j) {
+            if (j == i || orders[j]->symbol != o.symbol) continue;
+            const Order& other = *orders[j];
+            double otherPos = positionUsd_[posIndex(other.venue, other.symbol)];
+            double otherDelta = signedUsd(other.side, other.price * other.qty);
+            symGross += std::fabs(otherPos + otherDelta) - std::fabs(otherPos);
+            symNet += otherDelta;
+        }
+        if (limits_.maxSymbolGrossUsd > 0.0 && symGross > limits_.maxSymbolGrossUsd &&
+            symGross > symbolGross_[o.symbol]) {
+            return RiskReject::SymbolGross;
+        }
+        if (limits_.maxSymbolNetUsd > 0.0 && std::fabs(symNet) > limits_.maxSymbolNetUsd &&
+            std::fabs(symNet) > std::fabs(symbolNet_[o.symbol])) {
+            return RiskReject::SymbolNet;
+        }
+
+        grossDelta += legGross;
+        netDelta += delta;
+    }
+
+    // Limits only block orders that grow exposure, so unwinding is always allowed
+    if (limits_.maxGrossUsd > 0.0 && grossDelta > 0.0 && grossUsd_ + grossDelta > limits_.maxGrossUsd) {
+        return RiskReject::GlobalGross;
+    }
+    double net = netUsd_ + netDelta;
+    if (limits_.maxNetUsd > 0.0 && std::fabs(net) > limits_.maxNetUsd && std::fabs(net) > std::fabs(netUsd_)) {
+        return RiskReject::GlobalNet;
+    }
+    return RiskReject::None;
+}
+
+void RiskGate::onSend(const Order* const* orders, size_t count, int64_t nowNs) {
+    for (size_t i = 0; i < count; ++i) {
+        const Order& o = *orders[i];
+        Bucket& bucket = buckets_[o.venue];
+        if (bucket.ratePerNs > 0.0) {
+            bucket.available(nowNs);
+            bucket.tokens -= 1.0;
+        }
+        lastOrder_[lastIndex(o)] = { o.price, o.qty, nowNs };
+    }
+}
+
+void RiskGate::onFill(const Fill& fill) {
+    if (!fill.ok) return;
+    double& pos = positionUsd_[posIndex(fill.venue, fill.symbol)];
+    double delta = signedUsd(fill.side, fill.cost);
+    double grossDelta = std::fabs(pos + delta) - std::fabs(pos);
+
+    pos += delta;
+    symbolGross_[fill.symbol] += grossDelta;
+    symbolNet_[fill.symbol] += delta;
+    grossUsd_ += grossDelta;
+    netUsd_ += delta;
+}
+
+void RiskGate::onPnl(double pnlUsd) {
+    pnlUsd_ += pnlUsd;
+    if (!killed_ && limits_.maxLossUsd > 0.0 && pnlUsd_ <= -limits_.maxLossUsd) {
+        killed_ = true;
+        Logger::error("RISK kill switch: cumulative PnL $" + std::to_string(pnlUsd_) +
+                      " reached the loss limit of $" + std::to_string(limits_.maxLossUsd) + "; trading stopped");
+    }
+}
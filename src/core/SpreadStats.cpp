@@ -0,0 +1,112 @@
+#include "core/SpreadStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+P2Quantile::P2Quantile(double p)
+    : p_(p) {
+    for (int i = 0; i < 5; ++i) n_[i] = i;
+    np_[0] = 0; np_[1] = 2 * p; np_[2] = 4 * p; np_[3] = 2 + 2 * p; np_[4] = 4;
+    dn_[0] = 0; dn_[1] = p / 2; dn_[2] = p; dn_[3] = (1 + p) / 2; dn_[4] = 1;
+}
+
+void P2Quantile::add(double x) {
+    if (count_ < 5) {
+        q_[count_++] = x;
+        if (count_ == 5) std::sort(q_, q_ + 5);
+        return;
+    }
+    ++count_;
+
+    // Find the cell k containing x and extend the extremes.
+    int k;
+    if (x < q_[0]) { q_[0] = x; k = 0; }
+    else if (x >= q_[4]) { q_[4] = x; k = 3; }
+    else { k = 0; while (k < 3 && x >= q_[k + 1]) ++k; }
+
+    for (int i = k + 1; i < 5; ++i) n_[i] += 1;
+    for (int i = 0; i < 5; ++i) np_[i] += dn_[i];
+
+    // Adjust the three middle markers if they drifted off their desired positions.
+    for (int i = 1; i <= 3; ++i) {
+        double d = np_[i] - n_[i];
+        if ((d >= 1 && n_[i + 1] - n_[i] > 1) || (d <= -1 && n_[i - 1] - n_[i] < -1)) {
+            double s = d >= 0 ? 1.0 : -1.0;
+            // Piecewise-parabolic prediction, falling back to linear if it breaks ordering.
+            double qp = q_[i] + s / (n_[i + 1] - n_[i - 1]) *
+                        ((n_[i] - n_[i - 1] + s) * (q_[i + 1] - q_[i]) / (n_[i + 1] - n_[i]) +
+                         (n_[i + 1] - n_[i] - s) * (q_[i] - q_[i - 1]) / (n_[i] - n_[i - 1]));
+            if (q_[i - 1] < qp && qp < q_[i + 1]) {
+                q_[i] = qp;
+            } else {
+                int j = i + static_cast<int>(s);
+                q_[i] += s * (q_[j] - q_[i]) / (n_[j] - n_[i]);
+            }
+            n_[i] += s;
+        }
+    }
+}
+
+double P2Quantile::value() const {
+    if (count_ == 0) return 0.0;
+    if (count_ < 5) {
+        double tmp[5];
+        std::copy(q_, q_ + count_, tmp);
+        std::sort(tmp, tmp + count_);
+        size_t idx = static_cast<size_t>(std::round(p_ * static_cast<double>(count_ - 1)));
+        return tmp[idx];
+    }
+    return q_[2];
+}
+
+SpreadStats::SpreadStats(double alpha)
+    : alpha_(alpha) {}
+
+void SpreadStats::update(double spreadPct, double threshold, int64_t nowNs) {
+    last_ = spreadPct;
+    if (samples_++ == 0) {
+        ewma_ = spreadPct;
+        variance_ = 0.0;
+    } else {
+        // Incremental exponentially weighted mean and variance.
+        double diff = spreadPct - ewma_;
+        double incr = alpha_ * diff;
+        ewma_ += incr;
+        variance_ = (1.0 - alpha_) * (variance_ + diff * incr);
+    }
+
+    p50_.add(spreadPct);
+    p90_.add(spreadPct);
+    p99_.add(spreadPct);
+
+    bool above = spreadPct > threshold;
+    if (above && openSinceNs_ == 0) {
+        openSinceNs_ = nowNs;
+    } else if (!above && openSinceNs_ != 0) {
+        double ms = static_cast<double>(nowNs - openSinceNs_) / 1e6;
+        ++opportunities_;
+        totalOpportunityMs_ += ms;
+        maxOpportunityMs_ = std::max(maxOpportunityMs_, ms);
+        openSinceNs_ = 0;
+    }
+}
+
+double SpreadStats::stddev() const {
+    return std::sqrt(variance_);
+}
+
+SpreadStatsSnapshot SpreadStats::snapshot(int64_t nowNs) const {
+    SpreadStatsSnapshot s;
+    s.samples = samples_;
+    s.last = last_;
+    s.ewma = ewma_;
+    s.stddev = stddev();
+    s.p50 = p50_.value();
+    s.p90 = p90_.value();
+    s.p99 = p99_.value();
+    s.opportunities = opportunities_;
+    s.avgOpportunityMs = opportunities_ ? totalOpportunityMs_ / static_cast<double>(opportunities_) : 0.0;
+    s.maxOpportunityMs = maxOpportunityMs_;
+    s.openOpportunityMs = openSinceNs_ ? static_cast<double>(nowNs - openSinceNs_) / 1e6 : 0.0;
+    return s;
+}
@@ -0,0 +1,111 @@
+#include "core/StartupSequence.hpp"
+#include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+#include "core/Interner.hpp"
+
+#include <cstdio>
+#include <thread>
+
+namespace {
+    double msBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    std::string formatMs(double ms) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.1f ms", ms);
+        return buf;
+    }
+
+    constexpr size_t kMissingLogged = 10; // Unready books listed by name after a timeout
+}
+
+StartupSequence::StartupSequence()
+    : launch_(std::chrono::steady_clock::now()), phaseStart_(launch_) {}
+
+void StartupSequence::phase(const std::string& name) {
+    auto now = std::chrono::steady_clock::now();
+    double ms = msBetween(phaseStart_, now);
+    phases_.emplace_back(name, ms);
+    phaseStart_ = now;
+    Logger::info("Startup: " + name + " " + formatMs(ms) + " (" + formatMs(msBetween(launch_, now)) + " since launch)");
+}
+
+void StartupSequence::logSummary() const {
+    std::string line = "Startup: ready to trade " + formatMs(msBetween(launch_, phaseStart_)) + " after launch";
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        line += (i == 0 ? " | " : ", ") + phases_[i].first + "=" + formatMs(phases_[i].second);
+    }
+    Logger::info(line);
+}
+
+void StartupSequence::subscribeAll(const std::vector<std::shared_ptr<IExchangeClient>>& clients,
+                                   const std::vector<std::string>& symbols) {
+    // Each venue's REST/socket setup is independent; one thread per venue overlaps them.
+    std::vector<std::thread> threads;
+    threads.reserve(clients.size());
+    for (const auto& client : clients) {
+        threads.emplace_back([&client, &symbols]() {
+            RuntimeProfile::enterBackgroundThread(); // Created from the pinned engine thread
+            client->subscribeOrderBooks(symbols);
+        });
+    }
+    for (auto& t : threads) t.join();
+    Logger::info("Subscribed " + std::to_string(symbols.size()) + " symbols on " + std::to_string(clients.size()) +
+                 " venues");
+}
+
+StartupSequence::Readiness StartupSequence::waitForBooks(const std::vector<std::shared_ptr<IExchangeClient>>& clients,
+                                                         const std::vector<std::string>& symbols, double timeoutSec) {
+    using namespace std::chrono;
+    const auto start = steady_clock::now();
+    const auto deadline = start + duration_cast<steady_clock::duration>(duration<double>(timeoutSec));
+
+    std::vector<SymbolId> ids;
+    ids.reserve(symbols.size());
+    for (const auto& sym : symbols) ids.push_back(static_cast<SymbolId>(symbolTable().intern(sym)));
+
+    // Ready books are not polled again; a book replaced meanwhile is picked up by the engine.
+    Readiness result;
+    result.total = clients.size() * ids.size();
+    std::vector<bool> ready(result.total, false);
+    while (true) {
+        for (size_t c = 0; c < clients.size(); ++c) {
+            for (size_t s = 0; s < ids.size(); ++s) {
+                size_t k = c * ids.size() + s;
+                if (ready[k]) continue;
+                const OrderBook* ob = clients[c]->currentBook(ids[s]);
+                if (!ob) continue;
+                OrderBook::TopOfBook top = ob->getTop();
+                if (top.bid > 0.0 && top.ask > 0.0 && top.bid < top.ask) {
+                    ready[k] = true;
+                    ++result.ready;
+                }
+            }
+        }
+        if (result.ready == result.total || steady_clock::now() >= deadline) break;
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+
+    for (size_t k = 0; k < ready.size(); ++k) {
+        if (ready[k]) continue;
+        result.missing.push_back(clients[k / ids.size()]->getExchangeName() + ":" + symbols[k % ids.size()]);
+    }
+
+    std::string counts = std::to_string(result.ready) + "/" + std::to_string(result.total);
+    std::string elapsed = formatMs(msBetween(start, steady_clock::now()));
+    if (result.missing.empty()) {
+        Logger::info("Books ready: " + counts + " in " + elapsed);
+    } else {
+        std::string names;
+        for (size_t i = 0; i < result.missing.size() && i < kMissingLogged; ++i) {
+            names += (i ? ", " : "") + result.missing[i];
+        }
+        if (result.missing.size() > kMissingLogged) {
+            names += " and " + std::to_string(result.missing.size() - kMissingLogged) + " more";
+        }
+        Logger::warn("Books ready: only " + counts + " after " + elapsed + " (missing " + names +
+                     "); starting anyway");
+    }
+    return result;
+}
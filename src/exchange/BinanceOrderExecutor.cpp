@@ -0,0 +1,119 @@
+#include "exchange/BinanceOrderExecutor.hpp"
+
+#include "core/Interner.hpp"
+
+#include <charconv>
+
+BinanceOrderExecutor::BinanceOrderExecutor(std::string exchangeName, RestVenueConfig cfg)
+    : RestOrderExecutor(std::move(exchangeName), std::move(cfg)) {
+    const std::string& host = conn_.endpoint().host;
+    headers_ = "POST /fapi/v1/order HTTP/1.1\r\n"
+               "Host: " + host + "\r\n"
+               "X-MBX-APIKEY: " + cfg_.apiKey + "\r\n"
+               "Content-Type: application/x-www-form-urlencoded\r\n"
+               "Connection: keep-alive\r\n"
+               "Content-Length: ";
+    queryHeaders_ = " HTTP/1.1\r\n"
+                    "Host: " + host + "\r\n"
+                    "X-MBX-APIKEY: " + cfg_.apiKey + "\r\n"
+                    "Connection: keep-alive\r\n\r\n";
+    ping_ = "GET /fapi/v1/ping HTTP/1.1\r\nHost: " + host + "\r\nConnection: keep-alive\r\n\r\n";
+}
+
+void BinanceOrderExecutor::buildTemplate(const std::string& symbol, SymbolTemplate& tmpl) {
+    for (Side side : { Side::Buy, Side::Sell }) {
+        tmpl.prefix[static_cast<int>(side)] =
+            "symbol=" + symbol +
+            "&side=" + (side == Side::Buy ? "BUY" : "SELL") +
+            "&type=LIMIT&timeInForce=IOC&newOrderRespType=RESULT&quantity=";
+    }
+}
+
+void BinanceOrderExecutor::buildOrderRequest(const SymbolTemplate& tmpl, const Order& order, double price,
+                                             double qty, int64_t tsMs) {
+    body_.assign(tmpl.prefix[static_cast<int>(order.side)]);
+    appendDecimal(body_, qty, tmpl.qtyDecimals);
+    body_.append("&price=");
+    appendDecimal(body_, price, tmpl.priceDecimals);
+    body_.append("&newClientOrderId=");
+    body_.append(orderIdPrefix_);
+    appendInt(body_, order.id);
+    body_.append("&recvWindow=");
+    appendInt(body_, static_cast<uint64_t>(cfg_.recvWindowMs));
+    body_.append("&timestamp=");
+    appendInt(body_, static_cast<uint64_t>(tsMs));
+
+    // Signature covers the full query string.
+    signer_.signHex(body_, signature_);
+    body_.append("&signature=");
+    body_.append(signature_, HmacSha256::kHexSize);
+
+    request_.assign(headers_);
+    appendInt(request_, body_.size());
+    request_.append("\r\n\r\n");
+    request_.append(body_);
+}
+
+void BinanceOrderExecutor::parseAck(const HttpResponse& response, const Order& order, Fill& fill) {
+    (void)order;
+    if (response.status >= 500 || response.status == 408) {
+        // e.g. 503 "execution status unknown": the order may still have executed
+        fill.pending = true;
+        return;
+    }
+    if (response.status != 200) return;
+
+    // newOrderRespType=RESULT reports the IOC outcome directly.
+    parseExecution(response.body, fill);
+}
+
+void BinanceOrderExecutor::buildQueryRequest(const Fill& fill, int64_t tsMs) {
+    body_.assign("symbol=");
+    body_.append(symbolTable().name(fill.symbol));
+    body_.append("&origClientOrderId=");
+    body_.append(orderIdPrefix_);
+    appendInt(body_, fill.orderId);
+    body_.append("&recvWindow=");
+    appendInt(body_, static_cast<uint64_t>(cfg_.recvWindowMs));
+    body_.append("&timestamp=");
+    appendInt(body_, static_cast<uint64_t>(tsMs));
+    signer_.signHex(body_, signature_);
+    body_.append("&signature=");
+    body_.append(signature_, HmacSha256::kHexSize);
+
+    request_.assign("GET /fapi/v1/order?");
+    request_.append(body_);
+    request_.append(queryHeaders_);
+}
+
+void BinanceOrderExecutor::parseQuery(const HttpResponse& response, Fill& fill, bool windowPassed) {
+    if (response.status != 200) {
+        // -2013 "Order does not exist": final only once the order could no longer arrive
+        if (windowPassed && jsonField(response.body, "code") == "-2013") {
+            fill.pending = false;
+            fill.ok = false;
+            fill.qty = 0.0;
+        }
+        return;
+    }
+
+    std::string_view status = jsonField(response.body, "status");
+    if (status != "FILLED" && status != "CANCELED" && status != "EXPIRED" && status != "REJECTED" &&
+        status != "EXPIRED_IN_MATCH") {
+        return; // NEW / PARTIALLY_FILLED: still working
+    }
+    fill.pending = false;
+    parseExecution(response.body, fill);
+}
+
+void BinanceOrderExecutor::parseExecution(std::string_view body, Fill& fill) const {
+    fill.qty = 0.0;
+    fill.price = 0.0;
+    std::string_view executed = jsonField(body, "executedQty");
+    std::string_view avgPrice = jsonField(body, "avgPrice");
+    std::from_chars(executed.data(), executed.data() + executed.size(), fill.qty);
+    std::from_chars(avgPrice.data(), avgPrice.data() + avgPrice.size(), fill.price);
+
+    fill.fee = fill.price * fill.qty * (cfg_.takerFeePct / 100.0);
+    fill.ok = fill.qty > 0.0 && fill.price > 0.0;
+}
@@ -1,170 +1,109 @@
 #include "exchange/BybitFuturesClient.hpp"
-#include "common/Logger.hpp"
 
 #include <nlohmann/json.hpp>
 #include <algorithm>
-#include <thread>
-#include <chrono>
 
-BybitFuturesClient::BybitFuturesClient() {}
+template class FeedHandler<BybitProtocol>;
 
-BybitFuturesClient::~BybitFuturesClient() {
-    disconnect();
-}
-
-void BybitFuturesClient::connect() {
-    if (connected_) {
-        Logger::info("BybitFuturesClient is already connected.");
-        return;
-    }
-
-    Logger::info("Connecting to Bybit Futures WebSocket...");
-    connected_ = true;
-}
-
-void BybitFuturesClient::disconnect() {
-    if (!connected_) return;
-
-    Logger::info("Disconnecting from Bybit Futures...");
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (auto& [symbol, ws] : wsClients_) {
-        ws->stop();
-    }
-    wsClients_.clear();
-    connected_ = false;
-}
-
-void BybitFuturesClient::subscribeOrderBook(const std::string& symbol) {
-    if (!connected_) {
-        Logger::error("Cannot subscribe: BybitFuturesClient is not connected.");
-        return;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        // Create order book if not already present
-        if (orderBooks_.find(symbol) == orderBooks_.end()) {
-            orderBooks_[symbol] = std::make_shared<OrderBook>();
+namespace {
+    // Appends [["price","qty"], ...] levels to `out`.
+    void readLevels(const nlohmann::json& levels, std::vector<OrderBook::PriceLevel>& out) {
+        for (const auto& level : levels) {
+            out.emplace_back(std::stod(level[0].get<std::string>()), std::stod(level[1].get<std::string>()));
         }
     }
-
-    startWebSocket(symbol);
 }
 
-void BybitFuturesClient::startWebSocket(const std::string& symbol) {
+std::string BybitProtocol::routeKey(const std::string& symbol) {
     std::string upperSymbol = symbol;
     std::transform(upperSymbol.begin(), upperSymbol.end(), upperSymbol.begin(), ::toupper);
-    std::string topic = "orderbook.50." + upperSymbol;
-    std::string url = "wss://stream.bybit.com/v5/public/linear";
+    return "orderbook.50." + upperSymbol;
+}
 
-    Logger::info("Connecting to Bybit Futures WebSocket for: " + symbol);
+std::string BybitProtocol::url(const std::vector<std::string>&) {
+    return "wss://stream.bybit.com/v5/public/linear";
+}
 
-    std::shared_ptr<OrderBook> ob;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        ob = orderBooks_[symbol];
+std::vector<std::string> BybitProtocol::subscribeRequests(const std::vector<std::string>& keys) {
+    constexpr size_t kTopicsPerRequest = 10;
+    std::vector<std::string> requests;
+    for (size_t i = 0; i < keys.size(); i += kTopicsPerRequest) {
+        size_t end = std::min(keys.size(), i + kTopicsPerRequest);
+        nlohmann::json subscribeMsg = {
+            {"op", "subscribe"},
+            {"args", std::vector<std::string>(keys.begin() + i, keys.begin() + end)}
+        };
+        requests.push_back(subscribeMsg.dump());
     }
+    return requests;
+}
 
-    auto ws = std::make_unique<ix::WebSocket>();
-    ws->setUrl(url);
-
-    ws->setOnMessageCallback([this, symbol, topic, ob](const ix::WebSocketMessagePtr& msg) {
-        if (msg->type == ix::WebSocketMessageType::Message) {
-            try {
-                auto json = nlohmann::json::parse(msg->str);
-
-                if (!json.contains("topic") || json["topic"] != topic) return;
-
-                std::string type = json.value("type", "");
-                const auto& data = json["data"];
-
-                if (type == "snapshot") {
-                    ob->clear(); // Full reset on snapshot
-
-                    for (const auto& bid : data["b"]) {
-                        double price = std::stod(bid[0].get<std::string>());
-                        double qty   = std::stod(bid[1].get<std::string>());
-                        ob->updateBid(price, qty);
-                    }
+std::string BybitProtocol::unsubscribeRequest(const std::string& key) {
+    nlohmann::json msg = { {"op", "unsubscribe"}, {"args", {key}} };
+    return msg.dump();
+}
 
-                    for (const auto& ask : data["a"]) {
-                        double price = std::stod(ask[0].get<std::string>());
-                        double qty   = std::stod(ask[1].get<std::string>());
-                        ob->updateAsk(price, qty);
-                    }
-                } else if (type == "delta") {
-                    for (const auto& bid : data["b"]) {
-                        double price = std::stod(bid[0].get<std::string>());
-                        double qty   = std::stod(bid[1].get<std::string>());
-                        ob->updateBid(price, qty);
-                    }
+bool BybitProtocol::onGap(State& state, const std::string& key, OrderBook& ob) {
+    if (!state.synced) return true; // Already waiting for a snapshot
+    Logger::warnf("Bybit %s dropped frames after update %llu; book cleared until a new snapshot", key.c_str(),
+                  static_cast<unsigned long long>(state.lastUpdateId));
+    state.synced = false;
+    ob.clear();
+    return false;
+}
 
-                    for (const auto& ask : data["a"]) {
-                        double price = std::stod(ask[0].get<std::string>());
-                        double qty   = std::stod(ask[1].get<std::string>());
-                        ob->updateAsk(price, qty);
-                    }
+bool BybitProtocol::decode(State& state, const std::string& key, OrderBook& ob, std::string_view frame, bool last) {
+    // Staged per thread: a builder delivers one channel's batch before moving on,
+    // and inline parsing always passes last=true.
+    thread_local std::vector<OrderBook::PriceLevel> bids, asks;
+    thread_local bool snapshot = false, pending = false;
+    try {
+        auto json = nlohmann::json::parse(frame);
+
+        if (json.contains("topic") && json["topic"] == key) {
+            std::string type = json.value("type", "");
+            const auto& data = json["data"];
+            uint64_t updateId = data.value("u", uint64_t{0});
+            if (type == "snapshot") {
+                // Full reset (also sent with u=1 after a service restart): staged deltas no longer matter
+                bids.clear();
+                asks.clear();
+                snapshot = true;
+                state.synced = true;
+                state.lastUpdateId = updateId;
+                readLevels(data["b"], bids);
+                readLevels(data["a"], asks);
+                pending = true;
+            } else if (type == "delta" && state.synced && updateId > state.lastUpdateId) {
+                // Deltas before the first snapshot have no base; replayed ones were applied already
+                if (updateId != state.lastUpdateId + 1) {
+                    // A missed delta leaves levels that no later delta corrects
+                    Logger::warnf("Bybit %s skipped from update %llu to %llu; book cleared until a new snapshot",
+                                  key.c_str(), static_cast<unsigned long long>(state.lastUpdateId),
+                                  static_cast<unsigned long long>(updateId));
+                    state.synced = false;
+                    bids.clear();
+                    asks.clear();
+                    snapshot = pending = false;
+                    ob.clear();
+                    return false;
                 }
-            } catch (const std::exception& ex) {
-                Logger::error("Bybit WebSocket parse error: " + std::string(ex.what()));
+                state.lastUpdateId = updateId;
+                readLevels(data["b"], bids);
+                readLevels(data["a"], asks);
+                pending = true;
             }
-        } else if (msg->type == ix::WebSocketMessageType::Open) {
-            Logger::info("WebSocket opened for: " + symbol);
-
-            nlohmann::json subscribeMsg = {
-                {"op", "subscribe"},
-                {"args", {topic}}
-            };
-
-            std::lock_guard<std::mutex> lock(mutex_);
-            wsClients_[symbol]->send(subscribeMsg.dump());
-        } else if (msg->type == ix::WebSocketMessageType::Error) {
-            Logger::error("WebSocket error for " + symbol + ": " + msg->errorInfo.reason);
-            reconnectWithDelay(symbol);
-        } else if (msg->type == ix::WebSocketMessageType::Close) {
-            Logger::info("WebSocket closed for symbol: " + symbol);
-            reconnectWithDelay(symbol);
         }
-    });
-
-    ws->start();
-
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        wsClients_[symbol] = std::move(ws);
+    } catch (const std::exception& ex) {
+        Logger::error("Bybit WebSocket parse error: " + std::string(ex.what()));
     }
-}
-
-void BybitFuturesClient::reconnectWithDelay(const std::string& symbol) {
-    // Reconnect logic runs in a detached thread to avoid blocking
-    std::thread([this, symbol]() {
-        Logger::info("Reconnecting to Bybit for " + symbol + " after 3 seconds...");
-        std::this_thread::sleep_for(std::chrono::seconds(3));
 
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = wsClients_.find(symbol);
-            if (it != wsClients_.end()) {
-                Logger::info("Stopping old WebSocket before reconnecting: " + symbol);
-                it->second->stop();
-                wsClients_.erase(it);
-            }
-        }
-
-        startWebSocket(symbol);
-    }).detach();
-}
-
-std::shared_ptr<OrderBook> BybitFuturesClient::getOrderBook(const std::string& symbol) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = orderBooks_.find(symbol);
-    if (it != orderBooks_.end()) {
-        return it->second;
+    if (last && pending) {
+        // Later levels overwrite earlier ones, so the merged deltas apply in order
+        ob.apply(bids, asks, snapshot);
+        bids.clear();
+        asks.clear();
+        snapshot = pending = false;
     }
-    return nullptr;
+    return true;
 }
-
-std::string BybitFuturesClient::getExchangeName() const {
-    return "Bybit Futures";
-}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "exchange/InstrumentCatalog.hpp"
+#include "common/Logger.hpp"
+#include "net/HttpConnection.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    std::string readFile(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) throw std::runtime_error("Failed to open instrument fixture: " + path);
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    }
+
+    // GET `target` and return the body; throws on transport errors or non-200 replies.
+    std::string httpGet(HttpConnection& conn, const std::string& target) {
+        std::string request = "GET " + target + " HTTP/1.1\r\nHost: " + conn.endpoint().host +
+                              "\r\nAccept: application/json\r\nConnection: keep-alive\r\n\r\n";
+        HttpResponse resp;
+        if (!conn.roundTrip(request, resp)) {
+            throw std::runtime_error("GET " + conn.endpoint().host + target + " failed");
+        }
+        if (resp.status != 200) {
+            throw std::runtime_error("GET " + conn.endpoint().host + target + " returned " + std::to_string(resp.status));
+        }
+        return std::string(resp.body);
+    }
+
+    double toDouble(const nlohmann::json& v) {
+        return v.is_string() ? std::stod(v.get<std::string>()) : v.get<double>();
+    }
+}
+
+std::vector<Instrument> InstrumentCatalog::parseBinance(std::string_view json, const std::string& quote) {
+    std::vector<Instrument> out;
+    auto doc = nlohmann::json::parse(json);
+    for (const auto& s : doc.at("symbols")) {
+        if (s.value("contractType", "") != "PERPETUAL" || s.value("status", "") != "TRADING" ||
+            s.value("quoteAsset", "") != quote) {
+            continue;
+        }
+
+        Instrument inst;
+        inst.symbol = s.at("symbol").get<std::string>();
+        for (const auto& f : s.value("filters", nlohmann::json::array())) {
+            std::string type = f.value("filterType", "");
+            if (type == "PRICE_FILTER") inst.tickSize = toDouble(f.at("tickSize"));
+            else if (type == "LOT_SIZE") inst.lotSize = toDouble(f.at("stepSize"));
+        }
+        out.push_back(std::move(inst));
+    }
+    return out;
+}
+
+std::vector<Instrument> InstrumentCatalog::parseBybit(std::string_view json, const std::string& quote,
+                                                     std::string& nextCursor) {
+    std::vector<Instrument> out;
+    auto doc = nlohmann::json::parse(json);
+    if (doc.value("retCode", 0) != 0) {
+        throw std::runtime_error("Bybit instruments-info error: " + doc.value("retMsg", std::string("?")));
+    }
+
+    const auto& result = doc.at("result");
+    nextCursor = result.value("nextPageCursor", "");
+    for (const auto& s : result.at("list")) {
+        if (s.value("contractType", "") != "LinearPerpetual" || s.value("status", "") != "Trading" ||
+            s.value("quoteCoin", "") != quote) {
+            continue;
+        }
+
+        Instrument inst;
+        inst.symbol = s.at("symbol").get<std::string>();
+        if (s.contains("priceFilter")) inst.tickSize = toDouble(s["priceFilter"].at("tickSize"));
+        if (s.contains("lotSizeFilter")) inst.lotSize = toDouble(s["lotSizeFilter"].at("qtyStep"));
+        out.push_back(std::move(inst));
+    }
+    return out;
+}
+
+std::vector<Instrument> InstrumentCatalog::loadBinance(const UniverseSettings& settings, const std::string& restUrl) {
+    if (!settings.binanceFixture.empty()) {
+        return parseBinance(readFile(settings.binanceFixture), settings.quote);
+    }
+
+    HttpConnection conn(HttpEndpoint::parse(restUrl));
+    return parseBinance(httpGet(conn, "/fapi/v1/exchangeInfo"), settings.quote);
+}
+
+std::vector<Instrument> InstrumentCatalog::loadBybit(const UniverseSettings& settings, const std::string& restUrl) {
+    std::string cursor;
+    if (!settings.bybitFixture.empty()) {
+        return parseBybit(readFile(settings.bybitFixture), settings.quote, cursor);
+    }
+
+    // Results are paged; follow the cursor over one keep-alive connection.
+    HttpConnection conn(HttpEndpoint::parse(restUrl));
+    std::vector<Instrument> out;
+    do {
+        std::string target = "/v5/market/instruments-info?category=linear&limit=1000";
+        if (!cursor.empty()) target += "&cursor=" + cursor;
+        auto page = parseBybit(httpGet(conn, target), settings.quote, cursor);
+        out.insert(out.end(), std::make_move_iterator(page.begin()), std::make_move_iterator(page.end()));
+    } while (!cursor.empty());
+    return out;
+}
+
+Universe InstrumentCatalog::discover(const UniverseSettings& settings, const std::string& binanceRestUrl,
+                                     const std::string& bybitRestUrl) {
+    auto binance = loadBinance(settings, binanceRestUrl);
+    auto bybit = loadBybit(settings, bybitRestUrl);
+
+    Universe universe;
+    for (auto& inst : bybit) universe.bybit.emplace(inst.symbol, std::move(inst));
+    for (auto& inst : binance) {
+        if (universe.bybit.count(inst.symbol)) {
+            universe.symbols.push_back(inst.symbol);
+            universe.binance.emplace(inst.symbol, std::move(inst));
+        }
+    }
+    std::sort(universe.symbols.begin(), universe.symbols.end());
+    if (settings.maxSymbols > 0 && universe.symbols.size() > settings.maxSymbols) {
+        universe.symbols.resize(settings.maxSymbols);
+    }
+
+    // Keep only the chosen symbols' rules
+    auto prune = [&universe](std::unordered_map<std::string, Instrument>& rules) {
+        for (auto it = rules.begin(); it != rules.end();) {
+            if (std::binary_search(universe.symbols.begin(), universe.symbols.end(), it->first)) ++it;
+            else it = rules.erase(it);
+        }
+    };
+    prune(universe.binance);
+    prune(universe.bybit);
+
+    Logger::info("Universe: " + std::to_string(binance.size()) + " Binance and " + std::to_string(bybit.size()) +
+                 " Bybit " + settings.quote + " perpetuals, " + std::to_string(universe.symbols.size()) +
+                 " selected on both");
+    return universe;
+}
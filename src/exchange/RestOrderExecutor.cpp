@@ -0,0 +1,262 @@
+#include "exchange/RestOrderExecutor.hpp"
+#include "common/JsonScan.hpp"
+#include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+#include "core/Interner.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace {
+    int64_t epochMs() {
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+    // Decimal places needed to represent a tick/lot step (0.001 -> 3, 1 -> 0).
+    int decimalsFor(double step) {
+        if (step <= 0.0) return 8;
+        int d = 0;
+        while (d < 12 && std::fabs(step * std::pow(10.0, d) - std::round(step * std::pow(10.0, d))) > 1e-9) ++d;
+        return d;
+    }
+}
+
+RestOrderExecutor::RestOrderExecutor(std::string exchangeName, RestVenueConfig cfg)
+    : exchange_(std::move(exchangeName)),
+      venue_(static_cast<VenueId>(venueTable().intern(exchange_))),
+      cfg_(std::move(cfg)),
+      orderIdPrefix_("arb" + std::to_string(epochMs() / 1000) + "-"),
+      signer_(cfg_.secret),
+      conn_(HttpEndpoint::parse(cfg_.restUrl), cfg_.timeoutMs),
+      templates_(kMaxSymbols) {
+    body_.reserve(2048);
+    request_.reserve(4096);
+}
+
+RestOrderExecutor::~RestOrderExecutor() {
+    if (running_.exchange(false)) {
+        { std::lock_guard<std::mutex> lock(stopMutex_); }
+        stopCv_.notify_all();
+        if (keepAlive_.joinable()) keepAlive_.join();
+    }
+}
+
+void RestOrderExecutor::prepareSymbol(const std::string& symbol, double tickSize, double lotSize) {
+    SymbolId id = static_cast<SymbolId>(symbolTable().intern(symbol));
+    std::lock_guard<std::mutex> lock(mutex_);
+    SymbolTemplate& tmpl = templates_[id];
+    tmpl.tickSize = tickSize;
+    tmpl.lotSize = lotSize;
+    tmpl.priceDecimals = decimalsFor(tickSize);
+    tmpl.qtyDecimals = decimalsFor(lotSize);
+    buildTemplate(symbol, tmpl);
+    tmpl.ready = true;
+}
+
+bool RestOrderExecutor::warmUp() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto start = std::chrono::steady_clock::now();
+    HttpResponse resp;
+    if (!conn_.connect() || !conn_.roundTrip(pingRequest(), resp)) {
+        Logger::error("[LIVE/" + exchange_ + "] warm-up failed for " + cfg_.restUrl);
+        return false;
+    }
+    lastUse_ = std::chrono::steady_clock::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(lastUse_ - start).count();
+    Logger::info("[LIVE/" + exchange_ + "] connection warm: " + cfg_.restUrl + " handshake+ping=" +
+                 std::to_string(us) + "us status=" + std::to_string(resp.status));
+
+    if (cfg_.keepAliveSec > 0.0 && !running_.exchange(true)) {
+        keepAlive_ = std::thread([this]() { keepAliveLoop(); });
+    }
+    return true;
+}
+
+void RestOrderExecutor::keepAliveLoop() {
+    RuntimeProfile::enterBackgroundThread();
+
+    auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(cfg_.keepAliveSec));
+
+    while (running_.load()) {
+        {
+            std::unique_lock<std::mutex> wait(stopMutex_);
+            stopCv_.wait_for(wait, interval / 2, [this]() { return !running_.load(); });
+        }
+        if (!running_.load()) break;
+
+        // An order holding the connection keeps it alive anyway; never make one wait for a ping
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) continue;
+        if (std::chrono::steady_clock::now() - lastUse_ < interval) continue;
+
+        HttpResponse resp;
+        if (!conn_.roundTrip(pingRequest(), resp)) {
+            Logger::warn("[LIVE/" + exchange_ + "] keep-alive ping failed; reconnecting on next use");
+        }
+        lastUse_ = std::chrono::steady_clock::now();
+    }
+}
+
+Fill RestOrderExecutor::executeTrade(const Order& order) {
+    Fill f;
+    f.orderId = order.id;
+    f.symbol  = order.symbol;
+    f.venue   = venue_;
+    f.side    = order.side;
+
+    const std::string& symbol = symbolTable().name(order.symbol);
+    if (!templates_[order.symbol].ready) {
+        // Cold path: symbol was added after startup (e.g. by a config reload).
+        prepareSymbol(symbol);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const SymbolTemplate& tmpl = templates_[order.symbol];
+
+    // Round to venue increments: qty down to the lot size, price to the nearest tick.
+    double qty = order.qty;
+    double price = order.price;
+    if (tmpl.lotSize > 0.0) qty = std::floor(qty / tmpl.lotSize + 1e-9) * tmpl.lotSize;
+    if (tmpl.tickSize > 0.0) price = std::round(price / tmpl.tickSize) * tmpl.tickSize;
+    if (qty <= 0.0 || price <= 0.0) {
+        Logger::infof("[LIVE/%s] rejected %s %s: qty below lot size", exchange_.c_str(),
+                      sideName(order.side), symbol.c_str());
+        return f;
+    }
+
+    buildOrderRequest(tmpl, order, price, qty, epochMs());
+
+    auto sent = std::chrono::steady_clock::now();
+    HttpResponse resp;
+    bool delivered = conn_.roundTrip(request_, resp);
+    auto acked = std::chrono::steady_clock::now();
+    lastUse_ = acked;
+
+    f.ackLatencyUs = std::chrono::duration_cast<std::chrono::microseconds>(acked - sent).count();
+    f.ts = epochMs();
+
+    f.qty = qty;
+    f.price = price;
+    if (!delivered) {
+        // The venue may have executed it: reconcile by client order id before reporting
+        Logger::infof("[LIVE/%s] %s %s: no response, order state unknown; reconciling", exchange_.c_str(),
+                      sideName(order.side), symbol.c_str());
+        f.pending = true;
+        return awaitExecution(f, sent);
+    }
+
+    parseAck(resp, order, f);
+    if (!f.ok && !f.pending) {
+        Logger::infof("[LIVE/%s] rejected %s %s status=%d: %.*s", exchange_.c_str(), sideName(order.side),
+                      symbol.c_str(), resp.status, static_cast<int>(std::min<size_t>(resp.body.size(), 300)),
+                      resp.body.data());
+        return f;
+    }
+
+    if (f.pending) {
+        // Accepted, or fate unknown: report nothing filled until the venue confirms the execution
+        queryFill(f, sent);
+        if (f.pending) return awaitExecution(f, sent);
+    }
+    reportFill(f);
+    return f;
+}
+
+Fill RestOrderExecutor::awaitExecution(Fill& fill, std::chrono::steady_clock::time_point sent) {
+    const char* symbol = symbolTable().name(fill.symbol).c_str();
+    for (Unconfirmed& u : unconfirmed_) {
+        if (u.active) continue;
+        u = { true, fill, sent, std::chrono::steady_clock::now() + std::chrono::milliseconds(kQueryIntervalMs) };
+        ++unconfirmedCount_;
+        Logger::infof("[LIVE/%s] %s %s awaiting execution report ack=%lldus", exchange_.c_str(),
+                      sideName(fill.side), symbol, static_cast<long long>(fill.ackLatencyUs));
+        Fill accepted = fill;
+        accepted.qty = 0.0;
+        return accepted;
+    }
+    Logger::error("[LIVE/" + exchange_ + "] too many unconfirmed orders; " + symbol +
+                  " order state unknown, check the venue");
+    fill.pending = false;
+    fill.ok = false;
+    fill.qty = 0.0;
+    return fill;
+}
+
+size_t RestOrderExecutor::pollFills(Fill* out, size_t max) {
+    if (unconfirmedCount_ == 0) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t n = 0;
+    for (Unconfirmed& u : unconfirmed_) {
+        if (!u.active || n == max) continue;
+        auto now = std::chrono::steady_clock::now();
+        if (now < u.nextQuery) continue;
+
+        queryFill(u.fill, u.sent);
+        if (u.fill.pending) {
+            // Unresolved orders hold their symbol paused; keep asking, less often once overdue
+            if (!u.overdue && now - u.sent >= std::chrono::seconds(kConfirmTimeoutSec)) {
+                u.overdue = true;
+                Logger::error("[LIVE/" + exchange_ + "] no execution report for " +
+                              symbolTable().name(u.fill.symbol) + " order " + std::to_string(u.fill.orderId) +
+                              " after " + std::to_string(kConfirmTimeoutSec) +
+                              "s; symbol paused until the venue reports it, check the venue");
+            }
+            u.nextQuery = now + std::chrono::milliseconds(u.overdue ? kSlowQueryIntervalMs : kQueryIntervalMs);
+            continue;
+        }
+        reportFill(u.fill);
+        out[n++] = u.fill;
+        u.active = false;
+        --unconfirmedCount_;
+    }
+    return n;
+}
+
+void RestOrderExecutor::queryFill(Fill& fill, std::chrono::steady_clock::time_point sent) {
+    buildQueryRequest(fill, epochMs());
+    HttpResponse resp;
+    if (!conn_.roundTrip(request_, resp)) return;
+    lastUse_ = std::chrono::steady_clock::now();
+    // A second of slack covers clock skew between us and the venue
+    bool windowPassed = lastUse_ - sent > std::chrono::milliseconds(cfg_.recvWindowMs + 1000);
+    parseQuery(resp, fill, windowPassed);
+    fill.ts = epochMs();
+}
+
+void RestOrderExecutor::reportFill(Fill& fill) {
+    const char* symbol = symbolTable().name(fill.symbol).c_str();
+    if (fill.ok) {
+        fill.cost = std::round(fill.qty * fill.price * 100.0) / 100.0;
+        Logger::infof("[LIVE/%s] %s %s qty=%f @ %f ack=%lldus", exchange_.c_str(), sideName(fill.side),
+                      symbol, fill.qty, fill.price, static_cast<long long>(fill.ackLatencyUs));
+    } else {
+        Logger::infof("[LIVE/%s] %s %s not filled", exchange_.c_str(), sideName(fill.side), symbol);
+    }
+}
+
+void RestOrderExecutor::appendDecimal(std::string& out, double value, int decimals) {
+    char buf[64];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, decimals);
+    char* end = res.ptr;
+    // Trim trailing zeros (and a trailing point) for compact, canonical values.
+    if (decimals > 0) {
+        while (end > buf && end[-1] == '0') --end;
+        if (end > buf && end[-1] == '.') --end;
+    }
+    out.append(buf, end);
+}
+
+void RestOrderExecutor::appendInt(std::string& out, uint64_t value) {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+std::string_view RestOrderExecutor::jsonField(std::string_view body, std::string_view key) {
+    return ::jsonField(body, key);
+}
@@ -1,53 +1,233 @@
 #include "common/ConfigManager.hpp"
+#include "common/ConfigWatcher.hpp"
 #include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+#include "core/AdminServer.hpp"
 #include "core/ArbitrageEngine.hpp"
+#include "core/FramePipeline.hpp"
+#include "core/StartupSequence.hpp"
 #include "exchange/BinanceFuturesClient.hpp"
+#include "exchange/BinanceOrderExecutor.hpp"
 #include "exchange/BybitFuturesClient.hpp"
+#include "exchange/BybitOrderExecutor.hpp"
+#include "exchange/InstrumentCatalog.hpp"
+#include "storage/TickStore.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+
+namespace {
+    std::atomic<ArbitrageEngine*> runningEngine{ nullptr };
+
+    // SIGINT/SIGTERM: end the engine loop so main can flush and shut down in order.
+    void onShutdownSignal(int) {
+        if (ArbitrageEngine* engine = runningEngine.load()) engine->stop();
+    }
+}
 
 int main() {
+    StartupSequence startup;
     Logger::info("=== Starting Arbitrage Bot ===");
 
     // Load configuration from file
     ConfigManager::load("config.json");
 
+    // The engine runs on this thread: pin it before anything is allocated or spawned,
+    // so engine state is first-touched on the engine core.
+    RuntimeProfile::configure(ConfigManager::snapshot()->runtime);
+    RuntimeProfile::enterEngineThread();
+    const StartupSettings& startupCfg = ConfigManager::snapshot()->startup;
+    startup.phase("config");
+
+    // Universe mode: trade every perpetual listed on both venues instead of the configured symbols
+    const UniverseSettings& universeCfg = ConfigManager::snapshot()->universe;
+    Universe universe;
+    if (universeCfg.enabled) {
+        try {
+            universe = InstrumentCatalog::discover(universeCfg, ConfigManager::snapshot()->binance.restUrl,
+                                                   ConfigManager::snapshot()->bybit.restUrl);
+        } catch (const std::exception& ex) {
+            Logger::error("Symbol discovery failed: " + std::string(ex.what()));
+            return 1;
+        }
+        ConfigManager::overrideSymbols(universe.symbols);
+        startup.phase("discovery");
+    }
+
     std::string mode = ConfigManager::getMode();
     double fees = ConfigManager::getFeesPercent();
-    double maxPos = ConfigManager::getMaxPosUsd();
-    double minSpread = ConfigManager::getMinSpreadPercent();
-    double rebalanceMinSpread = ConfigManager::getRebalanceMinSpread();
-    double intervalSec = ConfigManager::getCheckIntervalSeconds();
     auto symbols = ConfigManager::getSymbols();
 
+    // Venue increments per symbol (known in universe mode); 0 = unrounded
+    auto increments = [](const std::unordered_map<std::string, Instrument>& rules, const std::string& sym) {
+        auto it = rules.find(sym);
+        return it != rules.end() ? it->second : Instrument{ sym, 0.0, 0.0 };
+    };
+
     // Set up exchange clients
     auto binance = std::make_shared<BinanceFuturesClient>();
     auto bybit = std::make_shared<BybitFuturesClient>();
     binance->connect();
     bybit->connect();
 
-    // Subscribe to order books for all symbols
-    for (const auto& sym : symbols) {
-        binance->subscribeOrderBook(sym);
-        bybit->subscribeOrderBook(sym);
+    std::vector<std::shared_ptr<IExchangeClient>> clients = { binance, bybit };
+
+    // Pipeline mode: socket threads only queue raw frames; book builders parse and apply them
+    std::shared_ptr<FramePipeline> pipeline;
+    if (ConfigManager::snapshot()->pipeline.enabled) {
+        pipeline = std::make_shared<FramePipeline>(ConfigManager::snapshot()->pipeline);
+        binance->setFramePipeline(pipeline);
+        bybit->setFramePipeline(pipeline);
+        pipeline->start();
     }
 
-    // Set up arbitrage engine
+    startup.phase("connect");
+
+    // Subscribe in batches: one socket carries many symbols; venues subscribe in parallel
+    // and their sockets connect in the background.
+    binance->setSubscribeBatchSize(universeCfg.subscribeBatch);
+    bybit->setSubscribeBatchSize(universeCfg.subscribeBatch);
+    StartupSequence::subscribeAll(clients, symbols);
+    startup.phase("subscribe");
+
+    // Readiness barrier: trade only once every venue/symbol book has a valid snapshot
+    StartupSequence::waitForBooks(clients, symbols, startupCfg.readyTimeoutSec);
+    startup.phase("books");
+
+    // Set up arbitrage engine (symbols and thresholds come from the config snapshot)
     ArbitrageEngine engine;
+    engine.setLaunchTime(startup.launch());
     engine.addExchangeClient(binance);
     engine.addExchangeClient(bybit);
-    engine.setSymbols(symbols);
-    engine.setConfig(minSpread, intervalSec, maxPos, rebalanceMinSpread);
-    
+    for (const auto& sym : symbols) {
+        engine.setLotSize(binance->getExchangeName(), sym, increments(universe.binance, sym).lotSize);
+        engine.setLotSize(bybit->getExchangeName(), sym, increments(universe.bybit, sym).lotSize);
+    }
+
+    // Tick history: top-of-book and spread changes, written by a background thread
+    std::shared_ptr<TickStore> tickStore;
+    if (ConfigManager::snapshot()->tickStore.enabled) {
+        tickStore = std::make_shared<TickStore>(ConfigManager::snapshot()->tickStore);
+        if (startupCfg.prefault) {
+            std::vector<SymbolId> ids;
+            for (const auto& sym : symbols) ids.push_back(static_cast<SymbolId>(symbolTable().intern(sym)));
+            tickStore->prepare(ids);
+        }
+        tickStore->start();
+        engine.setTickStore(tickStore);
+    }
+
     // Register executors: paper or live
     if (mode == "paper") {
         // Exchange names must exactly match getExchangeName()
-        engine.addExecutor(binance->getExchangeName(), std::make_shared<PaperTrader>(binance->getExchangeName(), fees));
-        engine.addExecutor(bybit->getExchangeName(),   std::make_shared<PaperTrader>(bybit->getExchangeName(),   fees));
+        const ConfigSnapshot* cfg = ConfigManager::snapshot();
+        PaperSimConfig sim;
+        sim.enabled = cfg->paperSimEnabled;
+        sim.latencyMs = cfg->paperLatencyMs;
+        sim.depthLevels = cfg->paperDepthLevels;
+        sim.slippagePct = cfg->paperSlippagePct;
+
+        for (const auto& client : clients) {
+            auto trader = std::make_shared<PaperTrader>(client->getExchangeName(), fees);
+            if (sim.enabled) trader->enableDepthSimulation(client, sim);
+            engine.addExecutor(client->getExchangeName(), trader);
+        }
     } else {
-        // TODO: add LiveTrader executors 
+        const ConfigSnapshot* cfg = ConfigManager::snapshot();
+        auto venueConfig = [cfg, fees](const VenueCredentials& creds) {
+            RestVenueConfig rc;
+            rc.apiKey = creds.apiKey;
+            rc.secret = creds.secret;
+            rc.restUrl = creds.restUrl;
+            rc.takerFeePct = fees;
+            rc.recvWindowMs = cfg->liveRecvWindowMs;
+            rc.keepAliveSec = cfg->liveKeepAliveSec;
+            rc.timeoutMs = cfg->liveTimeoutMs;
+            return rc;
+        };
+
+        auto binanceExec = std::make_shared<BinanceOrderExecutor>(binance->getExchangeName(), venueConfig(cfg->binance));
+        auto bybitExec = std::make_shared<BybitOrderExecutor>(bybit->getExchangeName(), venueConfig(cfg->bybit));
+
+        // Pre-serialize order templates and open warm connections before trading starts.
+        for (const auto& sym : symbols) {
+            Instrument b = increments(universe.binance, sym);
+            Instrument y = increments(universe.bybit, sym);
+            binanceExec->prepareSymbol(sym, b.tickSize, b.lotSize);
+            bybitExec->prepareSymbol(sym, y.tickSize, y.lotSize);
+        }
+        for (auto exec : { std::static_pointer_cast<RestOrderExecutor>(binanceExec),
+                           std::static_pointer_cast<RestOrderExecutor>(bybitExec) }) {
+            if (!exec->warmUp()) {
+                Logger::error("Live executor for " + exec->exchange() + " is not reachable; aborting");
+                return 1;
+            }
+            engine.addExecutor(exec->exchange(), exec);
+        }
     }
 
-    // Start main arbitrage loop
+    startup.phase("executors");
+
+    // Build engine state and attach books now, then run the hot path dry so the first
+    // live scan does not pay for first-touch page faults and cold caches.
+    engine.prepare();
+    startup.phase("prepare");
+    engine.warmUp(startupCfg.warmUpRounds);
+    startup.phase("warmup");
+    startup.logSummary();
+
+    // Hot reload: subscribe/unsubscribe symbols that changed; the engine picks up
+    // thresholds and the symbol list from the new snapshot on its next scan.
+    ConfigWatcher watcher("config.json", [&clients](const ConfigSnapshot& prev, const ConfigSnapshot& next) {
+        ConfigWatcher::SymbolDiff diff = ConfigWatcher::diffSymbols(prev, next);
+        if (!diff.added.empty()) {
+            for (const auto& client : clients) client->subscribeOrderBooks(diff.added);
+        }
+        for (const auto& sym : diff.removed) {
+            for (const auto& client : clients) client->unsubscribeOrderBook(sym);
+        }
+        if (next.mode != prev.mode || next.feesPercent != prev.feesPercent) {
+            Logger::warn("Changes to mode/fees take effect after a restart");
+        }
+    });
+    if (mode != "paper") {
+        // Live orders need per-symbol templates and lot sizes, set up above before
+        // trading; a symbol without them cannot be traded until a restart
+        watcher.setReloadCheck([symbols](const ConfigSnapshot&, const ConfigSnapshot& next) {
+            for (const auto& sym : next.symbols) {
+                if (std::find(symbols.begin(), symbols.end(), sym) == symbols.end()) {
+                    return "live mode cannot add " + sym + " without a restart";
+                }
+            }
+            return std::string();
+        });
+    }
+    watcher.start();
+
+    // Operator control socket (status, dumps, pause/resume, flatten, thresholds)
+    std::unique_ptr<AdminServer> admin;
+    if (ConfigManager::snapshot()->admin.enabled) {
+        admin = std::make_unique<AdminServer>(ConfigManager::snapshot()->admin, engine, clients);
+        admin->start();
+    }
+
+    // Start main arbitrage loop; it returns once a shutdown signal arrives
+    runningEngine = &engine;
+    std::signal(SIGINT, onShutdownSignal);
+    std::signal(SIGTERM, onShutdownSignal);
     engine.start();
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    runningEngine = nullptr;
+
+    Logger::info("=== Shutting down ===");
+    if (admin) admin->stop();
+    watcher.stop();
+    // Writes the rows the engine queued before it stopped
+    if (tickStore) tickStore->stop();
+    for (const auto& client : clients) client->disconnect();
+    if (pipeline) pipeline->stop();
 
     return 0;
 }
\ No newline at end of file
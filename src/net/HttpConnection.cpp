@@ -0,0 +1,338 @@
+#include "net/HttpConnection.hpp"
+#include "common/Logger.hpp"
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+    constexpr size_t kInitialBufferSize = 64 * 1024;
+
+    bool iequals(std::string_view a, std::string_view b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                   return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+               });
+    }
+
+    // Milliseconds left until `deadline` for poll(), at least 0.
+    int remainingMs(std::chrono::steady_clock::time_point deadline) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        return static_cast<int>(std::max<long long>(0, left.count()));
+    }
+
+    // Connects `fd` to `addr`, giving up at `deadline`.
+    bool connectBefore(int fd, const sockaddr* addr, socklen_t len, std::chrono::steady_clock::time_point deadline) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        int rc = ::connect(fd, addr, len);
+        if (rc != 0 && errno == EINPROGRESS) {
+            pollfd pfd{ fd, POLLOUT, 0 };
+            int err = 0;
+            socklen_t errLen = sizeof(err);
+            if (::poll(&pfd, 1, remainingMs(deadline)) == 1 &&
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &errLen) == 0 && err == 0) {
+                rc = 0;
+            }
+        }
+        fcntl(fd, F_SETFL, flags);
+        return rc == 0;
+    }
+
+    std::string_view trim(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+        return s;
+    }
+}
+
+HttpEndpoint HttpEndpoint::parse(const std::string& url) {
+    HttpEndpoint ep;
+    std::string_view rest(url);
+
+    if (rest.substr(0, 8) == "https://") {
+        rest.remove_prefix(8);
+    } else if (rest.substr(0, 7) == "http://") {
+        rest.remove_prefix(7);
+        ep.tls = false;
+        ep.port = 80;
+    } else {
+        throw std::invalid_argument("Unsupported URL scheme: " + url);
+    }
+
+    rest = rest.substr(0, rest.find('/'));
+    auto colon = rest.find(':');
+    ep.host = std::string(rest.substr(0, colon));
+    if (colon != std::string_view::npos) {
+        ep.port = static_cast<uint16_t>(std::stoi(std::string(rest.substr(colon + 1))));
+    }
+    if (ep.host.empty()) throw std::invalid_argument("Missing host in URL: " + url);
+    return ep;
+}
+
+HttpConnection::HttpConnection(HttpEndpoint endpoint, int timeoutMs)
+    : endpoint_(std::move(endpoint)), timeout_(timeoutMs > 0 ? timeoutMs : 0), buf_(kInitialBufferSize) {
+    body_.reserve(kInitialBufferSize);
+}
+
+HttpConnection::~HttpConnection() {
+    close();
+    if (sslCtx_) SSL_CTX_free(sslCtx_);
+}
+
+bool HttpConnection::connect() {
+    close();
+    auto deadline = timeout_.count() > 0 ? std::chrono::steady_clock::now() + timeout_
+                                         : std::chrono::steady_clock::time_point::max();
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res = nullptr;
+    std::string port = std::to_string(endpoint_.port);
+    if (getaddrinfo(endpoint_.host.c_str(), port.c_str(), &hints, &res) != 0 || !res) {
+        Logger::error("HTTP: cannot resolve " + endpoint_.host);
+        return false;
+    }
+
+    for (addrinfo* ai = res; ai; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (connectBefore(fd, ai->ai_addr, ai->ai_addrlen, deadline)) {
+            fd_ = fd;
+            break;
+        }
+        ::close(fd);
+    }
+    freeaddrinfo(res);
+
+    if (fd_ < 0) {
+        Logger::error("HTTP: cannot connect to " + endpoint_.host + ":" + port);
+        return false;
+    }
+
+    int one = 1;
+    setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(fd_, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
+
+    // Bounds every blocking send and receive, including those inside the TLS handshake
+    if (timeout_.count() > 0) {
+        timeval tv{};
+        tv.tv_sec = static_cast<time_t>(timeout_.count() / 1000);
+        tv.tv_usec = static_cast<suseconds_t>((timeout_.count() % 1000) * 1000);
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    }
+
+    if (!endpoint_.tls) return true;
+
+    if (!sslCtx_) {
+        sslCtx_ = SSL_CTX_new(TLS_client_method());
+        if (!sslCtx_) {
+            close();
+            return false;
+        }
+        SSL_CTX_set_default_verify_paths(sslCtx_);
+        SSL_CTX_set_verify(sslCtx_, SSL_VERIFY_PEER, nullptr);
+        SSL_CTX_set_mode(sslCtx_, SSL_MODE_AUTO_RETRY);
+    }
+
+    ssl_ = SSL_new(sslCtx_);
+    SSL_set_fd(ssl_, fd_);
+    SSL_set_tlsext_host_name(ssl_, endpoint_.host.c_str());
+    SSL_set1_host(ssl_, endpoint_.host.c_str());
+
+    if (SSL_connect(ssl_) != 1) {
+        char err[256];
+        ERR_error_string_n(ERR_get_error(), err, sizeof(err));
+        Logger::error("HTTP: TLS handshake with " + endpoint_.host + " failed: " + err);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void HttpConnection::close() {
+    if (ssl_) {
+        SSL_shutdown(ssl_);
+        SSL_free(ssl_);
+        ssl_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool HttpConnection::peerClosed() const {
+    char c;
+    ssize_t n = ::recv(fd_, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0) return true;                                        // Orderly shutdown
+    if (n < 0) return !(errno == EAGAIN || errno == EWOULDBLOCK);   // Error vs. nothing to read
+    return true;                                                     // Unsolicited bytes (e.g. close_notify)
+}
+
+bool HttpConnection::writeAll(const char* data, size_t len) {
+    while (len > 0) {
+        long n = ssl_ ? SSL_write(ssl_, data, static_cast<int>(len))
+                      : static_cast<long>(::send(fd_, data, len, MSG_NOSIGNAL));
+        if (n <= 0) {
+            if (!ssl_ && n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+long HttpConnection::readSome(char* data, size_t len) {
+    while (true) {
+        long n = ssl_ ? SSL_read(ssl_, data, static_cast<int>(len))
+                      : static_cast<long>(::recv(fd_, data, len, 0));
+        if (n < 0 && !ssl_ && errno == EINTR) continue;
+        return n;
+    }
+}
+
+bool HttpConnection::waitReadable() {
+    if (ssl_ && SSL_pending(ssl_) > 0) return true;
+    if (timeout_.count() == 0) return true;
+    pollfd pfd{ fd_, POLLIN, 0 };
+    while (true) {
+        int rc = ::poll(&pfd, 1, remainingMs(deadline_));
+        if (rc > 0) return true;
+        if (rc == 0) return false;
+        if (errno != EINTR) return false;
+    }
+}
+
+bool HttpConnection::roundTrip(std::string_view request, HttpResponse& response) {
+    if (!isOpen() || peerClosed()) {
+        if (!connect()) return false;
+    }
+    deadline_ = std::chrono::steady_clock::now() + timeout_;
+
+    if (!writeAll(request.data(), request.size())) {
+        close();
+        return false;
+    }
+
+    if (!readResponse(response)) {
+        if (timeout_.count() > 0 && std::chrono::steady_clock::now() >= deadline_) {
+            Logger::warnf("HTTP: no complete response from %s within %lld ms", endpoint_.host.c_str(),
+                          static_cast<long long>(timeout_.count()));
+        }
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool HttpConnection::readResponse(HttpResponse& response) {
+    size_t used = 0;
+
+    // Reads at least one more byte, growing the buffer for oversized responses.
+    auto fill = [&]() {
+        if (used == buf_.size()) buf_.resize(buf_.size() * 2);
+        if (!waitReadable()) return false;
+        long n = readSome(buf_.data() + used, buf_.size() - used);
+        if (n <= 0) return false;
+        used += static_cast<size_t>(n);
+        return true;
+    };
+
+    // Headers
+    size_t headerEnd = std::string_view::npos;
+    while (true) {
+        std::string_view view(buf_.data(), used);
+        headerEnd = view.find("\r\n\r\n");
+        if (headerEnd != std::string_view::npos) break;
+        if (!fill()) return false;
+    }
+    headerEnd += 4;
+
+    std::string_view headers(buf_.data(), headerEnd);
+    auto lineEnd = headers.find("\r\n");
+    std::string_view statusLine = headers.substr(0, lineEnd);
+    auto sp = statusLine.find(' ');
+    if (sp == std::string_view::npos) return false;
+    response.status = std::atoi(std::string(statusLine.substr(sp + 1, 3)).c_str());
+
+    long long contentLength = -1;
+    bool chunked = false;
+    bool closeAfter = false;
+    for (size_t pos = lineEnd + 2; pos < headerEnd - 2;) {
+        size_t end = headers.find("\r\n", pos);
+        std::string_view line = headers.substr(pos, end - pos);
+        pos = end + 2;
+
+        auto colon = line.find(':');
+        if (colon == std::string_view::npos) continue;
+        std::string_view name = trim(line.substr(0, colon));
+        std::string_view value = trim(line.substr(colon + 1));
+
+        if (iequals(name, "Content-Length")) {
+            contentLength = std::strtoll(std::string(value).c_str(), nullptr, 10);
+        } else if (iequals(name, "Transfer-Encoding")) {
+            chunked = iequals(value, "chunked");
+        } else if (iequals(name, "Connection")) {
+            closeAfter = iequals(value, "close");
+        }
+    }
+
+    if (chunked) {
+        body_.clear();
+        size_t pos = headerEnd;
+        while (true) {
+            size_t crlf;
+            while ((crlf = std::string_view(buf_.data(), used).find("\r\n", pos)) == std::string_view::npos) {
+                if (!fill()) return false;
+            }
+            size_t chunkSize = std::strtoul(std::string(buf_.data() + pos, crlf - pos).c_str(), nullptr, 16);
+            pos = crlf + 2;
+            if (chunkSize == 0) {
+                // Skip optional trailers up to the final empty line.
+                while (std::string_view(buf_.data(), used).find("\r\n", pos) == std::string_view::npos) {
+                    if (!fill()) return false;
+                }
+                break;
+            }
+            while (used < pos + chunkSize + 2) {
+                if (!fill()) return false;
+            }
+            body_.append(buf_.data() + pos, chunkSize);
+            pos += chunkSize + 2;
+        }
+        response.body = body_;
+    } else if (contentLength >= 0) {
+        size_t total = headerEnd + static_cast<size_t>(contentLength);
+        if (buf_.size() < total) buf_.resize(total);
+        while (used < total) {
+            if (!fill()) return false;
+        }
+        response.body = std::string_view(buf_.data() + headerEnd, static_cast<size_t>(contentLength));
+    } else {
+        // No framing: body runs to end of stream.
+        while (fill()) {}
+        response.body = std::string_view(buf_.data() + headerEnd, used - headerEnd);
+        closeAfter = true;
+    }
+
+    if (closeAfter) close();
+    return true;
+}
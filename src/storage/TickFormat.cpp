@@ -0,0 +1,149 @@
+#include "storage/TickFormat.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <zlib.h>
+
+namespace tickfmt {
+
+namespace {
+    void putVarint(std::string& out, uint64_t v) {
+        char buf[10];
+        size_t n = 0;
+        while (v >= 0x80) {
+            buf[n++] = static_cast<char>(v | 0x80);
+            v >>= 7;
+        }
+        buf[n++] = static_cast<char>(v);
+        out.append(buf, n);
+    }
+
+    uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    template <typename T>
+    void putRaw(std::string& out, T v) { out.append(reinterpret_cast<const char*>(&v), sizeof(T)); }
+
+    template <typename T>
+    bool getRaw(const uint8_t*& p, const uint8_t* end, T& v) {
+        if (static_cast<size_t>(end - p) < sizeof(T)) return false;
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+
+    // Decodes `rows` zigzag varints into out (as deltas), then prefix-sums them.
+    // Kept as two passes: the first is branchy byte work, the second a tight loop.
+    bool decodeColumn(const uint8_t* p, const uint8_t* end, size_t rows, int64_t* out) {
+        for (size_t i = 0; i < rows; ++i) {
+            uint64_t v = 0;
+            int shift = 0;
+            while (true) {
+                if (p == end || shift > 63) return false;
+                uint8_t byte = *p++;
+                v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) break;
+                shift += 7;
+            }
+            out[i] = unzigzag(v);
+        }
+        for (size_t i = 1; i < rows; ++i) out[i] += out[i - 1];
+        return p == end;
+    }
+}
+
+void encodeChunk(Table table, const Columns& columns, size_t rows, const std::vector<std::string>& venues,
+                 bool compress, std::string& out, std::string& scratch) {
+    const size_t ncols = columnCount(table);
+
+    scratch.clear();
+    scratch.push_back(static_cast<char>(venues.size()));
+    for (const auto& name : venues) {
+        scratch.push_back(static_cast<char>(std::min<size_t>(name.size(), 255)));
+        scratch.append(name, 0, 255);
+    }
+    std::string column;
+    for (size_t c = 0; c < ncols; ++c) {
+        column.clear();
+        int64_t prev = 0;
+        for (size_t r = 0; r < rows; ++r) {
+            putVarint(column, zigzag(columns[c][r] - prev));
+            prev = columns[c][r];
+        }
+        putRaw<uint32_t>(scratch, static_cast<uint32_t>(column.size()));
+        scratch += column;
+    }
+
+    ChunkHeader h;
+    h.rows = static_cast<uint32_t>(rows);
+    h.minTsUs = rows ? columns[0][0] : 0;
+    h.maxTsUs = rows ? columns[0][rows - 1] : 0;
+    h.table = static_cast<uint8_t>(table);
+    h.columns = static_cast<uint8_t>(ncols);
+    h.rawSize = static_cast<uint32_t>(scratch.size());
+
+    std::string packed;
+    if (compress) {
+        uLongf packedSize = compressBound(static_cast<uLong>(scratch.size()));
+        packed.resize(packedSize);
+        if (compress2(reinterpret_cast<Bytef*>(packed.data()), &packedSize,
+                      reinterpret_cast<const Bytef*>(scratch.data()), static_cast<uLong>(scratch.size()),
+                      Z_DEFAULT_COMPRESSION) == Z_OK && packedSize < scratch.size()) {
+            packed.resize(packedSize);
+            h.compressed = 1;
+        }
+    }
+
+    const std::string& payload = h.compressed ? packed : scratch;
+    h.payloadSize = static_cast<uint32_t>(payload.size());
+    out.append(reinterpret_cast<const char*>(&h), sizeof(h));
+    out += payload;
+}
+
+bool ChunkReader::next(ChunkView& chunk) {
+    if (size_ - pos_ < sizeof(ChunkHeader)) return false;
+    std::memcpy(&chunk.header, data_ + pos_, sizeof(ChunkHeader));
+    if (chunk.header.magic != kChunkMagic || chunk.header.columns > kMaxColumns) return false;
+    if (size_ - pos_ - sizeof(ChunkHeader) < chunk.header.payloadSize) return false;
+    chunk.payload = data_ + pos_ + sizeof(ChunkHeader);
+    pos_ += sizeof(ChunkHeader) + chunk.header.payloadSize;
+    return true;
+}
+
+bool decodeChunk(const ChunkView& chunk, Columns& columns, std::vector<std::string>& venues, std::string& scratch) {
+    const ChunkHeader& h = chunk.header;
+    const uint8_t* p = chunk.payload;
+    const uint8_t* end = p + h.payloadSize;
+
+    if (h.compressed) {
+        scratch.resize(h.rawSize);
+        uLongf rawSize = h.rawSize;
+        if (uncompress(reinterpret_cast<Bytef*>(scratch.data()), &rawSize, p, h.payloadSize) != Z_OK ||
+            rawSize != h.rawSize) {
+            return false;
+        }
+        p = reinterpret_cast<const uint8_t*>(scratch.data());
+        end = p + rawSize;
+    }
+
+    uint8_t venueCount = 0;
+    if (!getRaw(p, end, venueCount)) return false;
+    venues.resize(venueCount);
+    for (auto& name : venues) {
+        uint8_t len = 0;
+        if (!getRaw(p, end, len) || end - p < len) return false;
+        name.assign(reinterpret_cast<const char*>(p), len);
+        p += len;
+    }
+
+    for (size_t c = 0; c < h.columns; ++c) {
+        uint32_t len = 0;
+        if (!getRaw(p, end, len) || static_cast<size_t>(end - p) < len) return false;
+        columns[c].resize(h.rows);
+        if (!decodeColumn(p, p + len, h.rows, columns[c].data())) return false;
+        p += len;
+    }
+    return true;
+}
+
+} // namespace tickfmt
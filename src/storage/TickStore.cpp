@@ -0,0 +1,203 @@
+#include "storage/TickStore.hpp"
+#include "common/Logger.hpp"
+#include "common/RuntimeProfile.hpp"
+#include "core/Interner.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    constexpr int64_t kUsPerDay = 86400LL * 1000000LL;
+
+    int64_t nowUs() {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+    const char* tableName(tickfmt::Table table) {
+        return table == tickfmt::Table::Bbo ? "bbo" : "spread";
+    }
+
+    // Writes all of `data`, retrying partial writes; false on error or a full disk.
+    bool writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t n = ::write(fd, data, size);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+}
+
+TickStore::TickStore(TickStoreSettings settings)
+    : settings_(std::move(settings)), queue_(settings_.queueDepth), buffers_(size_t(kMaxSymbols) * 2) {
+    if (settings_.chunkRows == 0) settings_.chunkRows = 1;
+}
+
+TickStore::~TickStore() {
+    stop();
+}
+
+void TickStore::prepare(const std::vector<SymbolId>& symbols) {
+    if (running_.load()) return; // Buffers belong to the writer thread once it runs
+    for (SymbolId symbol : symbols) {
+        for (size_t table = 0; table < 2; ++table) {
+            for (auto& col : buffers_[size_t(symbol) * 2 + table].columns) col.resize(settings_.chunkRows);
+        }
+    }
+}
+
+void TickStore::start() {
+    if (running_.exchange(true)) return;
+    thread_ = std::thread([this]() { run(); });
+    Logger::info("Recording ticks to " + settings_.dir + (settings_.compress ? " (zlib)" : ""));
+}
+
+void TickStore::stop() {
+    if (!running_.exchange(false)) return;
+    if (thread_.joinable()) thread_.join();
+    Logger::info("Tick store stopped: rows=" + std::to_string(written()) + " dropped=" + std::to_string(dropped()));
+}
+
+void TickStore::recordTop(SymbolId symbol, VenueId venue, double bid, double bidQty, double ask, double askQty) {
+    Row row;
+    row.tsUs = nowUs();
+    row.symbol = symbol;
+    row.table = tickfmt::Table::Bbo;
+    row.a = venue;
+    row.v[0] = bid;
+    row.v[1] = bidQty;
+    row.v[2] = ask;
+    row.v[3] = askQty;
+    push(row);
+}
+
+void TickStore::recordSpread(SymbolId symbol, VenueId buyVenue, VenueId sellVenue, double spreadPct) {
+    Row row;
+    row.tsUs = nowUs();
+    row.symbol = symbol;
+    row.table = tickfmt::Table::Spread;
+    row.a = buyVenue;
+    row.b = sellVenue;
+    row.v[0] = spreadPct;
+    push(row);
+}
+
+void TickStore::push(const Row& row) {
+    if (!queue_.tryPush(row)) dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TickStore::run() {
+    RuntimeProfile::enterBackgroundThread();
+
+    const auto idle = std::chrono::milliseconds(20);
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(settings_.flushIntervalSec));
+    auto nextFlush = std::chrono::steady_clock::now() + interval;
+
+    Row row;
+    while (running_.load(std::memory_order_acquire)) {
+        size_t n = 0;
+        while (n < 4096 && queue_.tryPop(row)) {
+            append(row);
+            ++n;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextFlush) {
+            flushAll();
+            nextFlush = now + interval;
+        }
+        if (n == 0) std::this_thread::sleep_for(idle);
+    }
+
+    while (queue_.tryPop(row)) append(row);
+    flushAll();
+}
+
+void TickStore::append(const Row& row) {
+    using namespace tickfmt;
+    Buffer& buf = buffers_[size_t(row.symbol) * 2 + static_cast<size_t>(row.table)];
+
+    // A file covers one UTC day; close out the previous day's rows first.
+    int64_t day = row.tsUs / kUsPerDay;
+    if (buf.rows > 0 && day != buf.day) flush(row.symbol, row.table, buf);
+    buf.day = day;
+
+    if (buf.columns[0].size() <= buf.rows) {
+        for (auto& col : buf.columns) col.resize(settings_.chunkRows);
+    }
+
+    const size_t r = buf.rows;
+    if (row.table == Table::Bbo) {
+        buf.columns[kBboTs][r] = row.tsUs;
+        buf.columns[kBboVenue][r] = row.a;
+        buf.columns[kBboBid][r] = toFixed(row.v[0], kPriceScale);
+        buf.columns[kBboBidQty][r] = toFixed(row.v[1], kPriceScale);
+        buf.columns[kBboAsk][r] = toFixed(row.v[2], kPriceScale);
+        buf.columns[kBboAskQty][r] = toFixed(row.v[3], kPriceScale);
+    } else {
+        buf.columns[kSpreadTs][r] = row.tsUs;
+        buf.columns[kSpreadBuy][r] = row.a;
+        buf.columns[kSpreadSell][r] = row.b;
+        buf.columns[kSpreadPct][r] = toFixed(row.v[0], kSpreadScale);
+    }
+    if (++buf.rows >= settings_.chunkRows) flush(row.symbol, row.table, buf);
+}
+
+void TickStore::flushAll() {
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        if (buffers_[i].rows == 0) continue;
+        flush(static_cast<SymbolId>(i / 2), static_cast<tickfmt::Table>(i % 2), buffers_[i]);
+    }
+}
+
+void TickStore::flush(SymbolId symbol, tickfmt::Table table, Buffer& buf) {
+    // Venue indices in the rows are VenueIds; the chunk carries their names.
+    venues_.clear();
+    for (size_t v = 0; v < venueTable().size(); ++v) venues_.push_back(venueTable().name(static_cast<uint32_t>(v)));
+
+    chunk_.clear();
+    tickfmt::encodeChunk(table, buf.columns, buf.rows, venues_, settings_.compress, chunk_, scratch_);
+    const size_t rows = buf.rows;
+    buf.rows = 0;
+
+    std::string path = pathFor(symbol, table, buf.day);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        Logger::error("Tick store: cannot open " + path);
+        dropped_.fetch_add(rows, std::memory_order_relaxed);
+        return;
+    }
+    // A failed append is cut back to where it started, so the file never ends in a
+    // partial chunk that would hide the chunks appended after it from readers.
+    off_t start = ::lseek(fd, 0, SEEK_END);
+    bool ok = start >= 0 && writeAll(fd, chunk_.data(), chunk_.size());
+    if (!ok && start >= 0 && ::ftruncate(fd, start) != 0) {
+        Logger::error("Tick store: cannot truncate " + path + " after a failed write");
+    }
+    ::close(fd);
+    if (!ok) {
+        Logger::error("Tick store: short write to " + path);
+        dropped_.fetch_add(rows, std::memory_order_relaxed);
+        return;
+    }
+    written_.fetch_add(rows, std::memory_order_relaxed);
+}
+
+std::string TickStore::pathFor(SymbolId symbol, tickfmt::Table table, int64_t day) const {
+    std::time_t t = static_cast<std::time_t>(day * 86400);
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    char date[16];
+    std::strftime(date, sizeof(date), "%Y%m%d", &tm);
+    return settings_.dir + "/" + date + "/" + symbolTable().name(symbol) + "." + tableName(table) + ".tks";
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Bybit orderbook.50 frames for BTCUSDT, as the venue sends them.
+namespace bybit_frames {
+    inline const std::string kTopic = "orderbook.50.BTCUSDT";
+
+    inline std::string level(double price, double qty) {
+        return "[\"" + std::to_string(price) + "\",\"" + std::to_string(qty) + "\"]";
+    }
+
+    // One frame with a single bid and ask level.
+    inline std::string frame(const char* type, uint64_t u, const char* bid, const char* ask) {
+        return std::string(R"({"topic":")") + kTopic + R"(","type":")" + type + R"(","data":{"s":"BTCUSDT","b":[[")" +
+               bid + R"(","1"]],"a":[[")" + ask + R"(","1"]],"u":)" + std::to_string(u) + "}}";
+    }
+
+    // A 50-level snapshot (update id `firstId`, bids 100 and below, asks 100.1 and above)
+    // followed by `deltas` deltas that change levels within it, generated deterministically.
+    inline std::vector<std::string> burst(size_t deltas, uint64_t firstId = 1) {
+        std::vector<std::string> frames;
+        std::string bids, asks;
+        for (int i = 0; i < 50; ++i) {
+            bids += (i ? "," : "") + level(100.0 - i * 0.1, 1.0 + i);
+            asks += (i ? "," : "") + level(100.1 + i * 0.1, 1.0 + i);
+        }
+        frames.push_back(R"({"topic":")" + kTopic + R"(","type":"snapshot","data":{"b":[)" + bids + "],\"a\":[" + asks +
+                         "],\"u\":" + std::to_string(firstId) + "}}");
+
+        uint32_t seed = 12345;
+        for (size_t n = 1; n <= deltas; ++n) {
+            seed = seed * 1664525u + 1013904223u;
+            int bidLevel = static_cast<int>(seed % 50);
+            int askLevel = static_cast<int>((seed >> 8) % 50);
+            double qty = (seed >> 16) % 4; // 0 removes the level
+            frames.push_back(R"({"topic":")" + kTopic + R"(","type":"delta","data":{"b":[)" +
+                             level(100.0 - bidLevel * 0.1, qty) + "],\"a\":[" + level(100.1 + askLevel * 0.1, qty) +
+                             "],\"u\":" + std::to_string(firstId + n) + "}}");
+        }
+        return frames;
+    }
+}
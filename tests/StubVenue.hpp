@@ -0,0 +1,117 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Plain-HTTP venue on a loopback port, served by a background thread. Each request
+// is answered with whatever `respond` returns (a complete raw HTTP response); an
+// empty answer stalls the connection without replying, like a hung venue.
+class StubVenue {
+public:
+    using Responder = std::function<std::string(const std::string& request)>;
+
+    explicit StubVenue(Responder respond) : respond_(std::move(respond)) {
+        listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listenFd_, 8);
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() { serve(); });
+    }
+
+    ~StubVenue() {
+        running_ = false;
+        thread_.join();
+        for (int fd : clients_) ::close(fd);
+        ::close(listenFd_);
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+    size_t connections() const { return connections_.load(); }
+
+    // Requests received so far, in order.
+    std::vector<std::string> requests() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return requests_;
+    }
+
+    // Builds a response with a Content-Length body.
+    static std::string reply(const std::string& body, int status = 200) {
+        return "HTTP/1.1 " + std::to_string(status) + " OK\r\nContent-Type: application/json\r\nContent-Length: " +
+               std::to_string(body.size()) + "\r\nConnection: keep-alive\r\n\r\n" + body;
+    }
+
+private:
+    void serve() {
+        std::vector<std::string> pending;
+        while (running_) {
+            std::vector<pollfd> fds{ { listenFd_, POLLIN, 0 } };
+            for (int fd : clients_) fds.push_back({ fd, POLLIN, 0 });
+            if (::poll(fds.data(), fds.size(), 20) <= 0) continue;
+
+            if (fds[0].revents & POLLIN) {
+                clients_.push_back(::accept(listenFd_, nullptr, nullptr));
+                pending.emplace_back();
+                ++connections_;
+            }
+            for (size_t i = 1; i < fds.size(); ++i) {
+                if (!(fds[i].revents & (POLLIN | POLLHUP))) continue;
+                char buf[4096];
+                ssize_t n = ::recv(fds[i].fd, buf, sizeof(buf), 0);
+                if (n <= 0) continue;
+                pending[i - 1].append(buf, static_cast<size_t>(n));
+                answerComplete(fds[i].fd, pending[i - 1]);
+            }
+        }
+    }
+
+    // Answers every complete request buffered in `in` (headers plus Content-Length body).
+    void answerComplete(int fd, std::string& in) {
+        while (true) {
+            size_t headerEnd = in.find("\r\n\r\n");
+            if (headerEnd == std::string::npos) return;
+            size_t bodyLen = 0;
+            size_t cl = in.find("Content-Length: ");
+            if (cl != std::string::npos && cl < headerEnd) bodyLen = std::strtoul(in.c_str() + cl + 16, nullptr, 10);
+            size_t total = headerEnd + 4 + bodyLen;
+            if (in.size() < total) return;
+
+            std::string request = in.substr(0, total);
+            in.erase(0, total);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                requests_.push_back(request);
+            }
+            std::string out = respond_(request);
+            if (!out.empty()) ::send(fd, out.data(), out.size(), MSG_NOSIGNAL);
+        }
+    }
+
+    Responder respond_;
+    int listenFd_ = -1;
+    uint16_t port_ = 0;
+    std::vector<int> clients_;
+    std::atomic<bool> running_{true};
+    std::atomic<size_t> connections_{0};
+    mutable std::mutex mutex_;
+    std::vector<std::string> requests_;
+    std::thread thread_;
+};
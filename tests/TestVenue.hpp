@@ -0,0 +1,49 @@
+#pragma once
+
+#include "core/Interner.hpp"
+#include "exchange/IExchangeClient.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// In-memory exchange client: subscribing creates an empty book the test then feeds directly.
+class TestVenue : public IExchangeClient {
+public:
+    explicit TestVenue(std::string name) : name_(std::move(name)) {}
+
+    void connect() override {}
+    void disconnect() override {}
+
+    void subscribeOrderBook(const std::string& symbol) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& ob = books_[symbol];
+        ob = std::make_shared<OrderBook>();
+        publishBook(static_cast<SymbolId>(symbolTable().intern(symbol)), ob.get());
+    }
+
+    void unsubscribeOrderBook(const std::string& symbol) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        books_.erase(symbol);
+        publishBook(static_cast<SymbolId>(symbolTable().intern(symbol)), nullptr);
+    }
+
+    std::shared_ptr<OrderBook> getOrderBook(const std::string& symbol) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = books_.find(symbol);
+        return it == books_.end() ? nullptr : it->second;
+    }
+
+    std::string getExchangeName() const override { return name_; }
+
+    // Replaces the book's contents with one bid and one ask level.
+    void setTop(const std::string& symbol, double bid, double bidQty, double ask, double askQty) {
+        getOrderBook(symbol)->apply({ { bid, bidQty } }, { { ask, askQty } }, true);
+    }
+
+private:
+    std::string name_;
+    mutable std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<OrderBook>> books_;
+};
@@ -0,0 +1,181 @@
+#include "catch.hpp"
+#include "TestVenue.hpp"
+
+#include "common/ConfigManager.hpp"
+#include "core/AdminServer.hpp"
+#include "core/ArbitrageEngine.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    // Engine and admin server over two in-memory venues trading ADMINUSDT.
+    struct AdminFixture {
+        std::shared_ptr<TestVenue> a = std::make_shared<TestVenue>("A");
+        std::shared_ptr<TestVenue> b = std::make_shared<TestVenue>("B");
+        ArbitrageEngine engine;
+        AdminServer admin;
+        SymbolId symbol;
+
+        explicit AdminFixture(AdminSettings settings = {})
+            : admin(std::move(settings), engine, { a, b }) {
+            ConfigSnapshot cfg;
+            cfg.symbols = { "ADMINUSDT" };
+            cfg.minSpreadPercent = 1.0; // Books never cross
+            cfg.statsLogIntervalSec = 0.0;
+            ConfigManager::publish(cfg);
+
+            a->subscribeOrderBooks(cfg.symbols);
+            b->subscribeOrderBooks(cfg.symbols);
+            a->setTop("ADMINUSDT", 10.0, 3.0, 10.1, 4.0);
+            b->setTop("ADMINUSDT", 10.02, 5.0, 10.12, 6.0);
+            engine.addExchangeClient(a);
+            engine.addExchangeClient(b);
+            engine.prepare();
+            symbol = static_cast<SymbolId>(symbolTable().intern("ADMINUSDT"));
+        }
+    };
+
+    // Sends one command line over the socket and returns the reply line.
+    std::string roundTrip(const std::string& path, const std::string& line) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            return {};
+        }
+        std::string request = line + "\n";
+        ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+
+        std::string reply;
+        char chunk[4096];
+        while (reply.find('\n') == std::string::npos) {
+            pollfd pfd{ fd, POLLIN, 0 };
+            if (::poll(&pfd, 1, 2000) <= 0) break;
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) break;
+            reply.append(chunk, static_cast<size_t>(n));
+        }
+        ::close(fd);
+        return reply.substr(0, reply.find('\n'));
+    }
+}
+
+TEST_CASE("Admin set publishes the change and rejects values that are not positive and finite", "[admin]") {
+    AdminFixture f;
+    uint64_t version = ConfigManager::snapshot()->version;
+
+    nlohmann::json reply = f.admin.execute("set maxPosUsd 2500");
+    CHECK(reply["ok"] == true);
+    CHECK(ConfigManager::snapshot()->maxPosUsd == 2500.0);
+    CHECK(ConfigManager::snapshot()->version == version + 1);
+    CHECK(ConfigManager::snapshot()->symbols == std::vector<std::string>{ "ADMINUSDT" });
+
+    for (const char* bad : { "set maxPosUsd nan", "set maxPosUsd inf", "set minSpreadPercent -0.1",
+                             "set checkIntervalSec 0", "set maxPosUsd 12abc", "set maxPosUsd abc",
+                             "set feesPercent 0.1", "set maxPosUsd" }) {
+        INFO(bad);
+        CHECK(f.admin.execute(bad).contains("error"));
+    }
+    CHECK(ConfigManager::snapshot()->maxPosUsd == 2500.0);
+    CHECK(ConfigManager::snapshot()->version == version + 1);
+}
+
+TEST_CASE("Config updates are read-modify-publish with no writer in between", "[admin]") {
+    ConfigSnapshot cfg;
+    cfg.maxPosUsd = 0.0;
+    ConfigManager::publish(cfg);
+
+    // Each increment reads the snapshot the previous one published
+    auto bump = []() {
+        for (int i = 0; i < 500; ++i) ConfigManager::update([](ConfigSnapshot& next) { next.maxPosUsd += 1.0; });
+    };
+    std::thread other(bump);
+    bump();
+    other.join();
+    CHECK(ConfigManager::snapshot()->maxPosUsd == 1000.0);
+}
+
+TEST_CASE("Admin pause and resume flag symbols and venues", "[admin]") {
+    AdminFixture f;
+    VenueId venueB = static_cast<VenueId>(venueTable().intern("B"));
+
+    CHECK(f.admin.execute("pause symbol ADMINUSDT")["paused"] == true);
+    CHECK(f.engine.symbolPaused(f.symbol));
+    CHECK(f.admin.execute("pause venue B")["ok"] == true);
+    CHECK(f.engine.venuePaused(venueB));
+
+    nlohmann::json status = f.admin.execute("status");
+    CHECK(status["symbols"][0]["symbol"] == "ADMINUSDT");
+    CHECK(status["symbols"][0]["paused"] == true);
+    bool venuePaused = false;
+    for (const auto& venue : status["venues"]) {
+        if (venue["name"] == "B") venuePaused = venue["paused"];
+    }
+    CHECK(venuePaused);
+
+    f.admin.execute("resume symbol ADMINUSDT");
+    f.admin.execute("resume venue B");
+    CHECK_FALSE(f.engine.symbolPaused(f.symbol));
+    CHECK_FALSE(f.engine.venuePaused(venueB));
+
+    CHECK(f.admin.execute("pause symbol NOPEUSDT").contains("error"));
+    CHECK(f.admin.execute("pause venue Nowhere").contains("error"));
+    CHECK(f.admin.execute("pause thing ADMINUSDT").contains("error"));
+}
+
+TEST_CASE("Admin dump shows venue books and the consolidated book", "[admin]") {
+    AdminFixture f;
+    f.engine.scan();
+
+    nlohmann::json dump = f.admin.execute("dump ADMINUSDT 2");
+    REQUIRE(dump["books"].size() == 2);
+    CHECK(dump["books"][0]["venue"] == "A");
+    CHECK(dump["books"][0]["bids"][0][0] == 10.0);
+    CHECK(dump["books"][1]["asks"][0][1] == 6.0);
+    REQUIRE(dump["consolidated"].is_object());
+    CHECK(dump["consolidated"]["bids"].size() == 2);
+    CHECK(dump["positionsUsd"]["A"] == 0.0);
+
+    CHECK(f.admin.execute("dump NOPEUSDT").contains("error"));
+}
+
+TEST_CASE("Admin flatten and resubscribe act on configured symbols only", "[admin]") {
+    AdminFixture f;
+    CHECK(f.admin.execute("flatten ADMINUSDT")["queued"] == std::vector<std::string>{ "ADMINUSDT" });
+    CHECK(f.admin.execute("flatten all")["queued"] == std::vector<std::string>{ "ADMINUSDT" });
+    CHECK(f.admin.execute("flatten NOPEUSDT").contains("error"));
+
+    auto before = f.a->getOrderBook("ADMINUSDT");
+    CHECK(f.admin.execute("resubscribe ADMINUSDT")["ok"] == true);
+    CHECK(f.a->getOrderBook("ADMINUSDT") != before);
+    CHECK(f.admin.execute("resubscribe NOPEUSDT").contains("error"));
+
+    CHECK(f.admin.execute("frobnicate").contains("error"));
+    CHECK(f.admin.execute("help")["commands"].size() == 7);
+}
+
+TEST_CASE("The admin socket answers one JSON line per command", "[admin]") {
+    std::string path = (std::filesystem::temp_directory_path() / "admin_tests.sock").string();
+    AdminSettings settings;
+    settings.enabled = true;
+    settings.socketPath = path;
+    AdminFixture f(settings);
+    REQUIRE(f.admin.start());
+
+    nlohmann::json status = nlohmann::json::parse(roundTrip(path, "status"));
+    CHECK(status["symbols"][0]["symbol"] == "ADMINUSDT");
+    CHECK(nlohmann::json::parse(roundTrip(path, "set maxPosUsd -5")).contains("error"));
+
+    f.admin.stop();
+    CHECK_FALSE(std::filesystem::exists(path));
+}
@@ -0,0 +1,85 @@
+#include "catch.hpp"
+#include "TestVenue.hpp"
+
+#include "common/ConfigManager.hpp"
+#include "core/ArbitrageEngine.hpp"
+#include "core/PaperTrader.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every heap allocation in this executable goes through these; the test counts the
+// ones made while `counting` is set.
+namespace {
+    std::atomic<bool> counting{false};
+    std::atomic<size_t> allocations{0};
+
+    void* allocate(std::size_t size, std::size_t align) {
+        if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        void* p = align > alignof(std::max_align_t) ? std::aligned_alloc(align, (size + align - 1) / align * align)
+                                                    : std::malloc(size);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+}
+
+void* operator new(std::size_t size) { return allocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t align) { return allocate(size, static_cast<std::size_t>(align)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+TEST_CASE("A warmed-up scan that enters trades does not allocate", "[alloc]") {
+    ConfigSnapshot cfg;
+    cfg.symbols = { "BTCUSDT", "ETHUSDT" };
+    cfg.feesPercent = 0.0;
+    cfg.maxPosUsd = 1e12;
+    cfg.minSpreadPercent = 0.1;
+    cfg.statsLogIntervalSec = 0.0;
+    ConfigManager::publish(cfg);
+
+    auto a = std::make_shared<TestVenue>("A");
+    auto b = std::make_shared<TestVenue>("B");
+    a->subscribeOrderBooks(cfg.symbols);
+    b->subscribeOrderBooks(cfg.symbols);
+
+    auto engine = std::make_unique<ArbitrageEngine>();
+    engine->addExchangeClient(a);
+    engine->addExchangeClient(b);
+    engine->addExecutor("A", std::make_shared<PaperTrader>("A", 0.0));
+    engine->addExecutor("B", std::make_shared<PaperTrader>("B", 0.0));
+
+    // Every round moves every book and crosses A's bid over B's ask, so each scan enters
+    // both symbols. Book updates allocate (std::map levels), so only scan() is counted.
+    auto cross = [&](int round) {
+        double p = 100.0 + (round % 50) * 0.01;
+        for (const auto& symbol : cfg.symbols) {
+            a->setTop(symbol, p + 1.0, 1.0, p + 1.1, 1.0);
+            b->setTop(symbol, p - 1.1, 1.0, p - 1.0, 1.0);
+        }
+    };
+
+    engine->prepare();
+    engine->warmUp(10);
+    for (int round = 0; round < 100; ++round) {
+        cross(round);
+        engine->scan();
+    }
+
+    SymbolId btc = static_cast<SymbolId>(symbolTable().find("BTCUSDT"));
+    double warmPnl = engine->positions(btc).pnl;
+
+    allocations = 0;
+    for (int round = 0; round < 200; ++round) {
+        cross(round);
+        counting = true;
+        engine->scan();
+        counting = false;
+    }
+
+    REQUIRE(allocations == 0);
+    REQUIRE(engine->positions(btc).pnl > warmPnl); // The loop did trade
+}
@@ -0,0 +1,73 @@
+#include "catch.hpp"
+#include "TestVenue.hpp"
+
+#include "common/ConfigManager.hpp"
+#include "core/ArbitrageEngine.hpp"
+
+#include <memory>
+
+namespace {
+    ConsolidatedBook::Snapshot readMerged(const ArbitrageEngine& engine, const std::string& symbol) {
+        ConsolidatedBook::Snapshot snap;
+        engine.findConsolidatedBook(static_cast<SymbolId>(symbolTable().find(symbol)))->read(snap);
+        return snap;
+    }
+}
+
+TEST_CASE("The consolidated book merges venue tops after fees and follows resubscribed books", "[book]") {
+    ConfigSnapshot cfg;
+    cfg.symbols = { "SOLUSDT" };
+    cfg.feesPercent = 0.0;
+    cfg.minSpreadPercent = 5.0;
+    cfg.statsLogIntervalSec = 0.0;
+    ConfigManager::publish(cfg);
+
+    auto a = std::make_shared<TestVenue>("A");
+    auto b = std::make_shared<TestVenue>("B");
+    a->subscribeOrderBooks(cfg.symbols);
+    b->subscribeOrderBooks(cfg.symbols);
+    a->getOrderBook("SOLUSDT")->apply({ { 100.0, 1.0 }, { 99.0, 2.0 } }, { { 101.0, 1.0 } }, true);
+    b->getOrderBook("SOLUSDT")->apply({ { 100.0, 3.0 } }, { { 100.5, 1.0 }, { 101.0, 2.0 } }, true);
+
+    ArbitrageEngine engine;
+    engine.addExchangeClient(a);
+    engine.addExchangeClient(b);
+    engine.prepare();
+    engine.scan();
+
+    VenueId venueA = static_cast<VenueId>(venueTable().find("A"));
+    VenueId venueB = static_cast<VenueId>(venueTable().find("B"));
+    ConsolidatedBook::Snapshot snap = readMerged(engine, "SOLUSDT");
+    REQUIRE(snap.bidCount == 2);
+    REQUIRE(snap.askCount == 2);
+    CHECK(snap.bids[0].price == 100.0);
+    CHECK(snap.bids[0].qty == 4.0);
+    CHECK(snap.bids[0].venueQty[venueA] == 1.0);
+    CHECK(snap.bids[0].venueQty[venueB] == 3.0);
+    CHECK(snap.bids[1].price == 99.0);
+    CHECK(snap.asks[0].price == 100.5);
+    CHECK(snap.asks[1].qty == 3.0);
+
+    // Rewriting a level with the same quantity changes no merged level and is not republished
+    uint64_t version = snap.version;
+    a->getOrderBook("SOLUSDT")->updateBid(100.0, 1.0);
+    engine.scan();
+    CHECK(readMerged(engine, "SOLUSDT").version == version);
+    a->getOrderBook("SOLUSDT")->updateBid(99.5, 1.0);
+    engine.scan();
+    CHECK(readMerged(engine, "SOLUSDT").version == version + 1);
+
+    // A resubscribed venue is read from its new book; the old one no longer counts
+    std::shared_ptr<OrderBook> old = b->getOrderBook("SOLUSDT");
+    b->subscribeOrderBook("SOLUSDT");
+    b->setTop("SOLUSDT", 98.0, 5.0, 102.0, 5.0);
+    engine.scan();
+    old->updateBid(100.0, 9.0);
+    engine.scan();
+    snap = readMerged(engine, "SOLUSDT");
+    CHECK(snap.bids[0].price == 100.0);
+    CHECK(snap.bids[0].qty == 1.0);
+    CHECK(snap.bids[0].venueQty[venueB] == 0.0);
+    CHECK(snap.asks[0].price == 101.0);
+    CHECK(snap.asks[0].qty == 1.0);
+}
@@ -0,0 +1,127 @@
+#include "catch.hpp"
+#include "BybitFrames.hpp"
+#include "TestVenue.hpp"
+
+#include "common/ConfigManager.hpp"
+#include "common/LatencyHistogram.hpp"
+#include "core/ArbitrageEngine.hpp"
+#include "core/FramePipeline.hpp"
+#include "core/PaperTrader.hpp"
+#include "exchange/BybitFuturesClient.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+    int64_t elapsedNs(std::chrono::steady_clock::time_point from) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - from).count();
+    }
+
+    // Times one scan() into `hist`.
+    void timedScan(ArbitrageEngine& engine, LatencyHistogram& hist) {
+        auto t0 = std::chrono::steady_clock::now();
+        engine.scan();
+        hist.record(elapsedNs(t0));
+    }
+}
+
+// Replays a delta burst into one venue's book through the pipeline while the engine
+// scans: the queue stays within its depth, queued deltas are conflated into fewer book
+// versions, and a scan costs about the same as on a quiet feed.
+TEST_CASE("A replayed delta burst leaves decision latency flat", "[bench][pipeline]") {
+    ConfigSnapshot cfg;
+    cfg.symbols = { "BTCUSDT" };
+    cfg.minSpreadPercent = 1.0; // Books never cross; scans evaluate only
+    cfg.statsLogIntervalSec = 0.0;
+    ConfigManager::publish(cfg);
+
+    auto a = std::make_shared<TestVenue>("A");
+    auto bybit = std::make_shared<TestVenue>("Bybit");
+    a->subscribeOrderBooks(cfg.symbols);
+    bybit->subscribeOrderBooks(cfg.symbols);
+    a->setTop("BTCUSDT", 99.0, 1.0, 101.0, 1.0);
+    std::shared_ptr<OrderBook> book = bybit->getOrderBook("BTCUSDT");
+
+    PipelineSettings settings;
+    settings.enabled = true;
+    settings.queueDepth = 1024;
+    settings.statsLogIntervalSec = 0.0;
+    FramePipeline pipeline(settings);
+    BybitProtocol::State state;
+    std::atomic<int> resyncs{0};
+    auto channel = pipeline.addChannel("Bybit:BTCUSDT",
+        [&](std::string_view frame, int64_t, bool last) {
+            if (!BybitProtocol::decode(state, bybit_frames::kTopic, *book, frame, last)) ++resyncs;
+        },
+        [&]() {
+            if (!BybitProtocol::onGap(state, bybit_frames::kTopic, *book)) ++resyncs;
+        });
+    pipeline.start();
+
+    auto frames = bybit_frames::burst(50000);
+    REQUIRE(channel->push(frames[0]));
+    while (book->getTop().bid == 0.0) std::this_thread::yield();
+
+    ArbitrageEngine engine;
+    engine.addExchangeClient(a);
+    engine.addExchangeClient(bybit);
+    engine.addExecutor("A", std::make_shared<PaperTrader>("A", 0.0));
+    engine.addExecutor("Bybit", std::make_shared<PaperTrader>("Bybit", 0.0));
+    engine.prepare();
+    engine.warmUp(100);
+
+    constexpr int kQuietScans = 20000;
+    LatencyHistogram quiet;
+    for (int i = 0; i < kQuietScans; ++i) timedScan(engine, quiet);
+
+    // Socket-thread stand-in: bursts of back-to-back deltas, each far more than one scan
+    // covers, with a pause for the builder to drain before the next (one core suffices).
+    // A drained batch returns its buffers just after it is counted, so at most two bursts
+    // of buffers are ever out of the pool.
+    constexpr size_t kBurst = 256;
+    std::atomic<bool> done{false};
+    std::thread producer([&]() {
+        for (size_t i = 1; i < frames.size(); ++i) {
+            channel->push(frames[i]);
+            if (i % kBurst == 0) {
+                while (pipeline.stats().processed < i + 1) std::this_thread::yield();
+            }
+        }
+        done = true;
+    });
+
+    LatencyHistogram burst;
+    size_t peakDepth = 0;
+    uint64_t scans = 0;
+    while (!done) {
+        timedScan(engine, burst);
+        std::this_thread::yield();
+        if (++scans % 64 == 0) peakDepth = std::max(peakDepth, pipeline.stats().maxDepth);
+    }
+    producer.join();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pipeline.stats().processed < frames.size() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pipeline.stop();
+
+    FramePipeline::Stats stats = pipeline.stats();
+    std::printf("burst replay: %zu deltas, %llu conflated, peak queue %zu/%zu, %llu scans | "
+                "scan p99 quiet %lld ns, burst %lld ns\n",
+                frames.size() - 1, static_cast<unsigned long long>(stats.conflated), peakDepth, settings.queueDepth,
+                static_cast<unsigned long long>(scans), static_cast<long long>(quiet.percentile(0.99)),
+                static_cast<long long>(burst.percentile(0.99)));
+
+    // Bounded memory: the burst fit the fixed ring and buffer pool, nothing was dropped
+    CHECK(stats.dropped == 0);
+    CHECK(stats.processed == frames.size());
+    CHECK(peakDepth <= settings.queueDepth);
+    CHECK(resyncs == 0);
+    // Frames queued behind a busy builder were applied as one version
+    CHECK(book->version() <= frames.size() - stats.conflated);
+    // Flat decision latency: the burst costs the scan little beyond cache noise
+    CHECK(burst.percentile(0.99) <= std::max<int64_t>(quiet.percentile(0.99) * 4, quiet.percentile(0.99) + 20000));
+}
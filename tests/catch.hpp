@@ -0,0 +1,8 @@
+#pragma once
+
+// Catch2 v3 (vcpkg) or v2 (system packages)
+#if __has_include(<catch2/catch_all.hpp>)
+#include <catch2/catch_all.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
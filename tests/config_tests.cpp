@@ -0,0 +1,127 @@
+#include "catch.hpp"
+
+#include "common/ConfigManager.hpp"
+#include "common/ConfigWatcher.hpp"
+#include "core/Types.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Writes a config file listing `symbols`, moving its mtime forward so a watcher sees the change.
+    void writeConfig(const std::string& path, const std::vector<std::string>& symbols, double minSpread = 0.05) {
+        nlohmann::json cfg = { {"symbols", symbols}, {"minSpreadPercent", minSpread}, {"statsLogIntervalSec", 0} };
+        std::ofstream(path) << cfg.dump();
+        static auto stamp = std::filesystem::file_time_type::clock::now();
+        stamp += std::chrono::seconds(1);
+        std::filesystem::last_write_time(path, stamp);
+    }
+
+    std::string configPath() {
+        return (std::filesystem::temp_directory_path() / "config_tests.json").string();
+    }
+}
+
+TEST_CASE("A symbol diff lists added and removed symbols in order", "[config]") {
+    ConfigSnapshot prev, next;
+    prev.symbols = { "AUSDT", "BUSDT", "CUSDT" };
+    next.symbols = { "BUSDT", "DUSDT", "CUSDT", "EUSDT" };
+
+    ConfigWatcher::SymbolDiff diff = ConfigWatcher::diffSymbols(prev, next);
+    CHECK(diff.added == std::vector<std::string>{ "DUSDT", "EUSDT" });
+    CHECK(diff.removed == std::vector<std::string>{ "AUSDT" });
+    CHECK(ConfigWatcher::diffSymbols(next, next).added.empty());
+}
+
+TEST_CASE("A reload publishes the new symbols unless the file or the check rejects it", "[config]") {
+    std::string path = configPath();
+    writeConfig(path, { "CFGAUSDT", "CFGBUSDT" });
+    ConfigManager::load(path);
+
+    writeConfig(path, { "CFGBUSDT", "CFGCUSDT" }, 0.2);
+    REQUIRE(ConfigManager::reload());
+    CHECK(ConfigManager::snapshot()->symbols == std::vector<std::string>{ "CFGBUSDT", "CFGCUSDT" });
+    CHECK(ConfigManager::snapshot()->minSpreadPercent == 0.2);
+    uint64_t version = ConfigManager::snapshot()->version;
+
+    // The check sees the current snapshot and the candidate
+    writeConfig(path, { "CFGBUSDT", "CFGDUSDT" }, 0.3);
+    bool checked = false;
+    CHECK_FALSE(ConfigManager::reload([&](const ConfigSnapshot& current, const ConfigSnapshot& next) {
+        checked = current.version == version && next.symbols.back() == "CFGDUSDT";
+        return std::string("no new symbols");
+    }));
+    CHECK(checked);
+    CHECK(ConfigManager::snapshot()->version == version);
+
+    // More symbols than the process can intern: rejected before anything is published
+    std::vector<std::string> tooMany;
+    for (size_t i = 0; i <= kMaxSymbols; ++i) tooMany.push_back("CFG" + std::to_string(i) + "USDT");
+    writeConfig(path, tooMany);
+    CHECK_FALSE(ConfigManager::reload());
+    CHECK(ConfigManager::snapshot()->version == version);
+    CHECK_THROWS(ConfigManager::load(path));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("The watcher reloads a changed file and reports the symbol diff", "[config]") {
+    std::string path = configPath();
+    writeConfig(path, { "CFGAUSDT", "CFGBUSDT" });
+    ConfigManager::load(path);
+
+    std::mutex mutex;
+    std::vector<ConfigWatcher::SymbolDiff> diffs;
+    ConfigWatcher watcher(path, [&](const ConfigSnapshot& prev, const ConfigSnapshot& next) {
+        std::lock_guard<std::mutex> lock(mutex);
+        diffs.push_back(ConfigWatcher::diffSymbols(prev, next));
+    }, 0.05);
+    // Live-mode style check: nothing outside the starting list
+    watcher.setReloadCheck([](const ConfigSnapshot&, const ConfigSnapshot& next) {
+        for (const auto& sym : next.symbols) {
+            if (sym != "CFGAUSDT" && sym != "CFGBUSDT") return "cannot add " + sym;
+        }
+        return std::string();
+    });
+    watcher.start();
+
+    auto waitForDiffs = [&](size_t count) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (diffs.size() >= count) return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    };
+
+    writeConfig(path, { "CFGBUSDT" });
+    REQUIRE(waitForDiffs(1));
+    uint64_t version = ConfigManager::snapshot()->version;
+
+    // A rejected reload publishes nothing and reports no diff
+    writeConfig(path, { "CFGBUSDT", "CFGCUSDT" });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    CHECK(ConfigManager::snapshot()->version == version);
+
+    writeConfig(path, { "CFGBUSDT", "CFGAUSDT" });
+    REQUIRE(waitForDiffs(2));
+    watcher.stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    REQUIRE(diffs.size() == 2);
+    CHECK(diffs[0].added.empty());
+    CHECK(diffs[0].removed == std::vector<std::string>{ "CFGAUSDT" });
+    CHECK(diffs[1].added == std::vector<std::string>{ "CFGAUSDT" });
+    CHECK(diffs[1].removed.empty());
+    std::filesystem::remove(path);
+}
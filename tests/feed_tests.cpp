@@ -0,0 +1,49 @@
+#include "catch.hpp"
+#include "BybitFrames.hpp"
+
+#include "exchange/BybitFuturesClient.hpp"
+
+using bybit_frames::kTopic;
+using bybit_frames::frame;
+
+TEST_CASE("Bybit decoder applies contiguous deltas and ignores replays", "[feed]") {
+    BybitProtocol::State state;
+    OrderBook ob;
+
+    REQUIRE(BybitProtocol::decode(state, kTopic, ob, frame("snapshot", 10, "100", "101"), true));
+    REQUIRE(BybitProtocol::decode(state, kTopic, ob, frame("delta", 11, "100.5", "101"), true));
+    CHECK(ob.getTop().bid == 100.5);
+
+    // Already applied: dropped without losing sync
+    REQUIRE(BybitProtocol::decode(state, kTopic, ob, frame("delta", 11, "99", "101"), true));
+    CHECK(ob.getTop().bid == 100.5);
+    CHECK(state.synced);
+}
+
+TEST_CASE("Bybit decoder clears the book on a gap until the next snapshot", "[feed]") {
+    BybitProtocol::State state;
+    OrderBook ob;
+
+    REQUIRE(BybitProtocol::decode(state, kTopic, ob, frame("snapshot", 10, "100", "101"), true));
+    CHECK_FALSE(BybitProtocol::decode(state, kTopic, ob, frame("delta", 12, "100.5", "101"), true));
+    CHECK_FALSE(state.synced);
+    CHECK(ob.getTop().bid == 0.0);
+
+    // Later deltas have no base; the resync is only requested once
+    CHECK(BybitProtocol::decode(state, kTopic, ob, frame("delta", 13, "100.6", "101"), true));
+    CHECK(ob.getTop().bid == 0.0);
+
+    REQUIRE(BybitProtocol::decode(state, kTopic, ob, frame("snapshot", 20, "100.7", "101"), true));
+    REQUIRE(BybitProtocol::decode(state, kTopic, ob, frame("delta", 21, "100.8", "101"), true));
+    CHECK(ob.getTop().bid == 100.8);
+}
+
+TEST_CASE("Bybit decoder checks continuity across a staged batch", "[feed]") {
+    BybitProtocol::State state;
+    OrderBook ob;
+
+    REQUIRE(BybitProtocol::decode(state, kTopic, ob, frame("snapshot", 10, "100", "101"), true));
+    REQUIRE(BybitProtocol::decode(state, kTopic, ob, frame("delta", 11, "100.1", "101"), false));
+    CHECK_FALSE(BybitProtocol::decode(state, kTopic, ob, frame("delta", 13, "100.2", "101"), true));
+    CHECK(ob.getTop().bid == 0.0);
+}
@@ -0,0 +1,276 @@
+#include "catch.hpp"
+#include "StubVenue.hpp"
+
+#include "core/Interner.hpp"
+#include "exchange/BinanceOrderExecutor.hpp"
+#include "exchange/BybitOrderExecutor.hpp"
+#include "net/HttpConnection.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+    double elapsedMs(std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+
+    const std::string kGet = "GET /ping HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+
+    RestVenueConfig stubConfig(const StubVenue& venue, int timeoutMs = 1000) {
+        RestVenueConfig rc;
+        rc.apiKey = "key";
+        rc.secret = "secret";
+        rc.restUrl = venue.url();
+        rc.keepAliveSec = 0.0;
+        rc.timeoutMs = timeoutMs;
+        return rc;
+    }
+
+    Order stubOrder(uint64_t id, const char* venue, Side side) {
+        return { id, static_cast<SymbolId>(symbolTable().intern("BTCUSDT")),
+                 static_cast<VenueId>(venueTable().intern(venue)), side, 100.0, 0.5, 0 };
+    }
+
+    // Bybit order query reply for one order.
+    std::string bybitOrder(const char* status, const char* qty, const char* price, const char* fee) {
+        return StubVenue::reply(std::string(R"({"retCode":0,"retMsg":"OK","result":{"list":[{"orderStatus":")") +
+                                status + R"(","cumExecQty":")" + qty + R"(","avgPrice":")" + price +
+                                R"(","cumExecFee":")" + fee + R"("}]}})");
+    }
+
+    bool startsWith(const std::string& s, const char* prefix) { return s.rfind(prefix, 0) == 0; }
+}
+
+TEST_CASE("HttpConnection keeps one connection across round trips", "[http]") {
+    StubVenue venue([](const std::string&) { return StubVenue::reply("{}"); });
+    HttpConnection conn(HttpEndpoint::parse(venue.url()), 1000);
+
+    HttpResponse resp;
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(conn.roundTrip(kGet, resp));
+        CHECK(resp.status == 200);
+        CHECK(resp.body == "{}");
+    }
+    CHECK(venue.connections() == 1);
+}
+
+TEST_CASE("HttpConnection decodes chunked bodies", "[http]") {
+    StubVenue venue([](const std::string&) {
+        return std::string("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                           "4\r\n{\"a\"\r\n3\r\n:1}\r\n0\r\n\r\n");
+    });
+    HttpConnection conn(HttpEndpoint::parse(venue.url()), 1000);
+
+    HttpResponse resp;
+    REQUIRE(conn.roundTrip(kGet, resp));
+    CHECK(resp.body == "{\"a\":1}");
+}
+
+TEST_CASE("HttpConnection gives up on a venue that never answers", "[http]") {
+    StubVenue venue([](const std::string&) { return std::string(); });
+    HttpConnection conn(HttpEndpoint::parse(venue.url()), 200);
+
+    auto start = std::chrono::steady_clock::now();
+    HttpResponse resp;
+    CHECK_FALSE(conn.roundTrip(kGet, resp));
+    CHECK(elapsedMs(start) < 1000.0);
+    CHECK_FALSE(conn.isOpen());
+}
+
+TEST_CASE("HttpConnection gives up on a response that stops halfway", "[http]") {
+    StubVenue venue([](const std::string&) {
+        return std::string("HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\n{\"partial\":");
+    });
+    HttpConnection conn(HttpEndpoint::parse(venue.url()), 200);
+
+    auto start = std::chrono::steady_clock::now();
+    HttpResponse resp;
+    CHECK_FALSE(conn.roundTrip(kGet, resp));
+    CHECK(elapsedMs(start) < 1000.0);
+}
+
+TEST_CASE("Binance executor reports stub venue fills with ack latency", "[live]") {
+    StubVenue venue([](const std::string& request) {
+        if (startsWith(request, "GET /fapi/v1/ping")) return StubVenue::reply("{}");
+        return StubVenue::reply(R"({"orderId":1,"status":"FILLED","executedQty":"0.5","avgPrice":"100.1"})");
+    });
+
+    BinanceOrderExecutor exec("stub_binance", stubConfig(venue));
+    exec.prepareSymbol("BTCUSDT", 0.1, 0.001);
+    REQUIRE(exec.warmUp());
+
+    Fill fill = exec.executeTrade(stubOrder(1, "stub_binance", Side::Buy));
+
+    REQUIRE(fill.ok);
+    CHECK(fill.qty == Approx(0.5));
+    CHECK(fill.price == Approx(100.1));
+    CHECK(fill.ackLatencyUs > 0);
+    CHECK(venue.connections() == 1); // The warm connection carried the order
+
+    auto requests = venue.requests();
+    REQUIRE(requests.size() == 2);
+    CHECK(startsWith(requests[1], "POST /fapi/v1/order"));
+    CHECK(requests[1].find("signature=") != std::string::npos);
+}
+
+TEST_CASE("An order to a hung venue is reconciled by client order id", "[live]") {
+    StubVenue venue([](const std::string& request) {
+        if (startsWith(request, "GET /fapi/v1/ping")) return StubVenue::reply("{}");
+        if (startsWith(request, "GET /fapi/v1/order?")) {
+            return StubVenue::reply(R"({"orderId":1,"status":"FILLED","executedQty":"0.5","avgPrice":"100.3"})");
+        }
+        return std::string(); // The order itself is never answered
+    });
+
+    BinanceOrderExecutor exec("stub_binance", stubConfig(venue, 200));
+    exec.prepareSymbol("BTCUSDT", 0.1, 0.001);
+    REQUIRE(exec.warmUp());
+
+    auto start = std::chrono::steady_clock::now();
+    Fill fill = exec.executeTrade(stubOrder(2, "stub_binance", Side::Sell));
+    CHECK(elapsedMs(start) < 1000.0);
+    CHECK(fill.pending);
+    CHECK_FALSE(fill.ok);
+    CHECK(fill.qty == 0.0);
+
+    // It did execute: the query finds it and reports the fill
+    Fill fills[4];
+    std::this_thread::sleep_for(std::chrono::milliseconds(BinanceOrderExecutor::kQueryIntervalMs + 10));
+    REQUIRE(exec.pollFills(fills, 4) == 1);
+    CHECK(fills[0].orderId == 2);
+    CHECK(fills[0].ok);
+    CHECK(fills[0].qty == Approx(0.5));
+    CHECK(fills[0].price == Approx(100.3));
+
+    auto requests = venue.requests();
+    REQUIRE(requests.size() >= 3);
+    CHECK(startsWith(requests.back(), "GET /fapi/v1/order?symbol=BTCUSDT&origClientOrderId="));
+    CHECK(requests.back().find("signature=") != std::string::npos);
+}
+
+TEST_CASE("A Binance order with unknown execution status is queried before it is reported", "[live]") {
+    StubVenue venue([](const std::string& request) {
+        if (startsWith(request, "GET /fapi/v1/ping")) return StubVenue::reply("{}");
+        if (startsWith(request, "GET /fapi/v1/order?")) {
+            return StubVenue::reply(R"({"status":"EXPIRED","executedQty":"0.2","avgPrice":"100.1"})");
+        }
+        return StubVenue::reply(R"({"code":-1007,"msg":"Timeout waiting for response from backend server. )"
+                                R"(Send status unknown; execution status unknown."})", 503);
+    });
+
+    BinanceOrderExecutor exec("stub_binance", stubConfig(venue));
+    exec.prepareSymbol("BTCUSDT", 0.1, 0.001);
+    REQUIRE(exec.warmUp());
+
+    Fill fill = exec.executeTrade(stubOrder(6, "stub_binance", Side::Buy));
+    REQUIRE(fill.ok);
+    CHECK_FALSE(fill.pending);
+    CHECK(fill.qty == Approx(0.2));
+}
+
+TEST_CASE("An unknown order the venue never had is reported unfilled once its window passes", "[live]") {
+    StubVenue venue([](const std::string& request) {
+        if (startsWith(request, "GET /fapi/v1/ping")) return StubVenue::reply("{}");
+        if (startsWith(request, "GET /fapi/v1/order?")) {
+            return StubVenue::reply(R"({"code":-2013,"msg":"Order does not exist."})", 400);
+        }
+        return StubVenue::reply("{}", 502);
+    });
+
+    RestVenueConfig rc = stubConfig(venue);
+    rc.recvWindowMs = 0; // Resolved one second (the clock skew allowance) after sending
+    BinanceOrderExecutor exec("stub_binance", rc);
+    exec.prepareSymbol("BTCUSDT", 0.1, 0.001);
+    REQUIRE(exec.warmUp());
+
+    auto start = std::chrono::steady_clock::now();
+    Fill fill = exec.executeTrade(stubOrder(7, "stub_binance", Side::Buy));
+    REQUIRE(fill.pending);
+
+    // Not found is not final while the order could still arrive
+    Fill fills[4];
+    size_t n = 0;
+    while (n == 0 && elapsedMs(start) < 3000.0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(BinanceOrderExecutor::kQueryIntervalMs));
+        n = exec.pollFills(fills, 4);
+    }
+    REQUIRE(n == 1);
+    CHECK(elapsedMs(start) >= 1000.0);
+    CHECK_FALSE(fills[0].ok);
+    CHECK_FALSE(fills[0].pending);
+    CHECK(fills[0].qty == 0.0);
+}
+
+TEST_CASE("Bybit executor reports the queried execution, not the acknowledgement", "[live]") {
+    StubVenue venue([](const std::string& request) {
+        if (startsWith(request, "GET /v5/market/time")) return StubVenue::reply("{}");
+        if (startsWith(request, "POST /v5/order/create")) return StubVenue::reply(R"({"retCode":0,"retMsg":"OK"})");
+        return bybitOrder("PartiallyFilledCanceled", "0.3", "100.2", "0.018");
+    });
+
+    BybitOrderExecutor exec("stub_bybit", stubConfig(venue));
+    exec.prepareSymbol("BTCUSDT", 0.1, 0.001);
+    REQUIRE(exec.warmUp());
+
+    Fill fill = exec.executeTrade(stubOrder(3, "stub_bybit", Side::Buy));
+
+    REQUIRE(fill.ok);
+    CHECK_FALSE(fill.pending);
+    CHECK(fill.qty == Approx(0.3));
+    CHECK(fill.price == Approx(100.2));
+    CHECK(fill.fee == Approx(0.018));
+
+    auto requests = venue.requests();
+    REQUIRE(requests.size() == 3);
+    CHECK(startsWith(requests[2], "GET /v5/order/realtime?category=linear&symbol=BTCUSDT&orderLinkId="));
+    CHECK(requests[2].find("X-BAPI-SIGN: ") != std::string::npos);
+}
+
+TEST_CASE("Bybit executor reports a working order as pending until it is final", "[live]") {
+    std::atomic<bool> final{false};
+    StubVenue venue([&final](const std::string& request) {
+        if (startsWith(request, "GET /v5/market/time")) return StubVenue::reply("{}");
+        if (startsWith(request, "POST /v5/order/create")) return StubVenue::reply(R"({"retCode":0,"retMsg":"OK"})");
+        return final ? bybitOrder("Filled", "0.5", "99.9", "0.03") : bybitOrder("New", "0", "", "0");
+    });
+
+    BybitOrderExecutor exec("stub_bybit", stubConfig(venue));
+    exec.prepareSymbol("BTCUSDT", 0.1, 0.001);
+    REQUIRE(exec.warmUp());
+
+    Fill accepted = exec.executeTrade(stubOrder(4, "stub_bybit", Side::Sell));
+    CHECK(accepted.pending);
+    CHECK_FALSE(accepted.ok);
+    CHECK(accepted.qty == 0.0);
+
+    Fill fills[4];
+    std::this_thread::sleep_for(std::chrono::milliseconds(BybitOrderExecutor::kQueryIntervalMs + 10));
+    CHECK(exec.pollFills(fills, 4) == 0); // Still working
+
+    final = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(BybitOrderExecutor::kQueryIntervalMs + 10));
+    REQUIRE(exec.pollFills(fills, 4) == 1);
+    CHECK(fills[0].orderId == 4);
+    CHECK(fills[0].ok);
+    CHECK_FALSE(fills[0].pending);
+    CHECK(fills[0].qty == Approx(0.5));
+    CHECK(fills[0].price == Approx(99.9));
+    CHECK(exec.pollFills(fills, 4) == 0);
+}
+
+TEST_CASE("Bybit executor does not query a rejected order", "[live]") {
+    StubVenue venue([](const std::string& request) {
+        if (startsWith(request, "GET /v5/market/time")) return StubVenue::reply("{}");
+        return StubVenue::reply(R"({"retCode":10001,"retMsg":"params error"})");
+    });
+
+    BybitOrderExecutor exec("stub_bybit", stubConfig(venue));
+    exec.prepareSymbol("BTCUSDT", 0.1, 0.001);
+    REQUIRE(exec.warmUp());
+
+    Fill fill = exec.executeTrade(stubOrder(5, "stub_bybit", Side::Buy));
+    CHECK_FALSE(fill.ok);
+    CHECK_FALSE(fill.pending);
+    CHECK(venue.requests().size() == 2);
+}
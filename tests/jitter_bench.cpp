@@ -0,0 +1,76 @@
+#include "catch.hpp"
+#include "TestVenue.hpp"
+
+#include "common/ConfigManager.hpp"
+#include "common/LatencyHistogram.hpp"
+#include "core/ArbitrageEngine.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+    // Runs the engine loop in one pacing mode while a feed thread moves a book every
+    // `gap`, and returns the engine's book->engine detection delays.
+    LatencyHistogram detectionDelays(bool busyPoll, int updates, std::chrono::microseconds gap) {
+        ConfigSnapshot cfg;
+        cfg.symbols = { "XRPUSDT" };
+        cfg.minSpreadPercent = 50.0; // Books never cross
+        cfg.statsLogIntervalSec = 0.0;
+        cfg.checkIntervalSeconds = 0.001;
+        cfg.runtime.busyPoll = busyPoll;
+        ConfigManager::publish(cfg);
+
+        auto a = std::make_shared<TestVenue>("A");
+        auto b = std::make_shared<TestVenue>("B");
+        a->subscribeOrderBooks(cfg.symbols);
+        b->subscribeOrderBooks(cfg.symbols);
+        a->setTop("XRPUSDT", 0.50, 100.0, 0.51, 100.0);
+        b->setTop("XRPUSDT", 0.50, 100.0, 0.51, 100.0);
+
+        ArbitrageEngine engine;
+        engine.addExchangeClient(a);
+        engine.addExchangeClient(b);
+        engine.prepare();
+        engine.warmUp(10);
+        std::thread loop([&engine]() { engine.start(); });
+
+        // Feed thread stand-in: updates at uneven points relative to the engine's sleeps
+        for (int i = 0; i < updates; ++i) {
+            std::this_thread::sleep_for(gap + std::chrono::microseconds((i * 37) % 200));
+            a->setTop("XRPUSDT", 0.50, 100.0 + i % 10, 0.51, 100.0);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        engine.stop();
+        loop.join();
+        return engine.detectLatency();
+    }
+
+    void print(const char* mode, const LatencyHistogram& hist) {
+        std::printf("detection %-9s n=%llu p50=%lld ns p99=%lld ns p99.9=%lld ns max=%lld ns\n", mode,
+                    static_cast<unsigned long long>(hist.count()), static_cast<long long>(hist.percentile(0.50)),
+                    static_cast<long long>(hist.percentile(0.99)), static_cast<long long>(hist.percentile(0.999)),
+                    static_cast<long long>(hist.max()));
+    }
+}
+
+// Feed-to-engine detection delay with the engine sleeping checkIntervalSeconds between
+// scans versus busy-polling; the spinning loop should cut the tail by an order of magnitude.
+TEST_CASE("Busy-polling cuts the detection tail of the sleeping loop", "[bench][runtime]") {
+    constexpr int kUpdates = 1000;
+    LatencyHistogram sleeping = detectionDelays(false, kUpdates, std::chrono::microseconds(300));
+    LatencyHistogram polling = detectionDelays(true, kUpdates, std::chrono::microseconds(300));
+    print("sleep", sleeping);
+    print("busy-poll", polling);
+
+    // The sleeping loop sees only the latest of the updates made during a sleep
+    CHECK(sleeping.count() > 0);
+    CHECK(polling.count() > kUpdates / 2);
+    // A spinning engine shares a single core with the feed thread and only runs when
+    // preempted, so the comparison needs a core for each
+    if (std::thread::hardware_concurrency() < 2) {
+        WARN("one CPU: busy-poll comparison skipped");
+        return;
+    }
+    CHECK(polling.percentile(0.999) * 10 < sleeping.percentile(0.999));
+}
@@ -0,0 +1,141 @@
+#include "catch.hpp"
+#include "TestVenue.hpp"
+
+#include "core/FillSimulator.hpp"
+#include "core/PaperTrader.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace {
+    int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    SymbolId sym(const std::string& name) { return static_cast<SymbolId>(symbolTable().intern(name)); }
+
+    Order order(uint64_t id, SymbolId symbol, Side side, double price, double qty) {
+        Order o;
+        o.id = id;
+        o.symbol = symbol;
+        o.side = side;
+        o.price = price;
+        o.qty = qty;
+        return o;
+    }
+}
+
+TEST_CASE("Simulated fills consume levels across orders until the venue refreshes them", "[paper]") {
+    OrderBook book;
+    book.apply({ { 99.0, 1.0 }, { 98.0, 2.0 } }, { { 100.0, 1.0 }, { 101.0, 2.0 }, { 102.0, 3.0 } }, true);
+    FillSimulator sim(10);
+    SymbolId symbol = sym("PAPERSIMUSDT");
+
+    SimulatedFill first = sim.match(symbol, book, Side::Buy, 105.0, 2.0);
+    CHECK(first.qty == Approx(2.0));
+    CHECK(first.avgPrice == Approx(100.5));
+    CHECK(first.levels == 2);
+
+    // The same depth is not filled twice
+    SimulatedFill second = sim.match(symbol, book, Side::Buy, 105.0, 2.0);
+    CHECK(second.qty == Approx(2.0));
+    CHECK(second.avgPrice == Approx(101.5));
+
+    // A venue update to a level restores it; untouched consumed levels stay taken
+    book.updateAsk(101.0, 5.0);
+    SimulatedFill third = sim.match(symbol, book, Side::Buy, 105.0, 1.0);
+    CHECK(third.avgPrice == Approx(101.0));
+    CHECK(third.levels == 1);
+
+    // Bids are tracked separately
+    SimulatedFill sell = sim.match(symbol, book, Side::Sell, 90.0, 2.0);
+    CHECK(sell.qty == Approx(2.0));
+    CHECK(sell.avgPrice == Approx((99.0 + 98.0) / 2.0));
+}
+
+TEST_CASE("A simulated order fills partially when depth or the limit runs out", "[paper]") {
+    OrderBook book;
+    book.apply({ { 99.0, 1.0 } }, { { 100.0, 1.0 }, { 101.0, 2.0 }, { 102.0, 3.0 } }, true);
+    SymbolId symbol = sym("PAPERPARTUSDT");
+
+    FillSimulator deep(10);
+    SimulatedFill all = deep.match(symbol, book, Side::Buy, 200.0, 10.0);
+    CHECK(all.qty == Approx(6.0));
+    CHECK(all.avgPrice == Approx((100.0 + 202.0 + 306.0) / 6.0));
+    CHECK(all.levels == 3);
+    CHECK(deep.match(symbol, book, Side::Buy, 200.0, 1.0).qty == 0.0);
+
+    FillSimulator limited(10);
+    SimulatedFill capped = limited.match(symbol, book, Side::Buy, 101.0, 10.0);
+    CHECK(capped.qty == Approx(3.0));
+    CHECK(capped.levels == 2);
+
+    // Only the visible depth counts
+    FillSimulator shallow(1);
+    CHECK(shallow.match(symbol, book, Side::Buy, 200.0, 10.0).qty == Approx(1.0));
+}
+
+TEST_CASE("Paper fills stop at the slippage cap from the reference price", "[paper]") {
+    auto venue = std::make_shared<TestVenue>("A");
+    venue->subscribeOrderBook("PAPERSLIPUSDT");
+    venue->getOrderBook("PAPERSLIPUSDT")->apply({ { 99.8, 5.0 }, { 99.7, 5.0 } },
+                                                 { { 100.0, 1.0 }, { 100.04, 1.0 }, { 100.2, 5.0 } }, true);
+
+    PaperSimConfig cfg;
+    cfg.slippagePct = 0.05; // Buys up to 100.05, sells down to 99.85
+    PaperTrader trader("A", 0.1);
+    trader.enableDepthSimulation(venue, cfg);
+    SymbolId symbol = sym("PAPERSLIPUSDT");
+
+    Fill buy = trader.executeTrade(order(1, symbol, Side::Buy, 100.0, 5.0));
+    REQUIRE(buy.ok);
+    CHECK_FALSE(buy.pending);
+    CHECK(buy.qty == Approx(2.0));
+    CHECK(buy.price == Approx(100.02));
+    CHECK(buy.fee == Approx(2.0 * 100.02 * 0.001));
+
+    Fill sell = trader.executeTrade(order(2, symbol, Side::Sell, 100.0, 5.0));
+    CHECK_FALSE(sell.ok);
+    CHECK(sell.qty == 0.0);
+}
+
+TEST_CASE("Paper fills with latency arrive through pollFills, timed from the send", "[paper]") {
+    auto venue = std::make_shared<TestVenue>("B");
+    venue->subscribeOrderBook("PAPERLAGUSDT");
+    venue->setTop("PAPERLAGUSDT", 99.0, 1.0, 100.0, 1.0);
+
+    PaperSimConfig cfg;
+    cfg.latencyMs = 30.0;
+    PaperTrader trader("B", 0.0);
+    trader.enableDepthSimulation(venue, cfg);
+    SymbolId symbol = sym("PAPERLAGUSDT");
+
+    // Sent 10 ms before it reached the executor
+    Order buy = order(7, symbol, Side::Buy, 100.0, 2.0);
+    buy.ts = nowNs() - 10000000;
+    auto handed = std::chrono::steady_clock::now();
+    Fill ack = trader.executeTrade(buy);
+    CHECK(ack.pending);
+    CHECK_FALSE(ack.ok);
+    CHECK(ack.qty == 0.0);
+
+    Fill fills[4];
+    size_t n = trader.pollFills(fills, 4);
+    CHECK(n == 0);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (n == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        n = trader.pollFills(fills, 4);
+    }
+    auto waitedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handed).count();
+
+    REQUIRE(n == 1);
+    CHECK(fills[0].orderId == 7);
+    CHECK(fills[0].ok);
+    CHECK_FALSE(fills[0].pending);
+    CHECK(fills[0].qty == Approx(1.0));
+    CHECK(fills[0].price == Approx(100.0));
+    CHECK(fills[0].ackLatencyUs >= 30000);
+    CHECK(fills[0].ackLatencyUs >= waitedUs);
+}
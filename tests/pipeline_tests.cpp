@@ -0,0 +1,103 @@
+#include "catch.hpp"
+#include "BybitFrames.hpp"
+
+#include "core/FramePipeline.hpp"
+#include "exchange/BybitFuturesClient.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using bybit_frames::kTopic;
+
+    PipelineSettings pipelineSettings(size_t depth) {
+        PipelineSettings settings;
+        settings.enabled = true;
+        settings.queueDepth = depth;
+        settings.statsLogIntervalSec = 0.0;
+        return settings;
+    }
+
+    // Waits until the builder has handled `frames` frames.
+    bool waitProcessed(const FramePipeline& pipeline, uint64_t frames) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pipeline.stats().processed < frames) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    // Wires a Bybit book to a channel the way FeedHandler does, counting resync requests.
+    struct BybitChannel {
+        BybitProtocol::State state;
+        OrderBook book;
+        int resyncs = 0;
+        std::shared_ptr<FramePipeline::Channel> channel;
+
+        explicit BybitChannel(FramePipeline& pipeline) {
+            channel = pipeline.addChannel("Bybit:BTCUSDT",
+                [this](std::string_view frame, int64_t, bool last) {
+                    if (!BybitProtocol::decode(state, kTopic, book, frame, last)) ++resyncs;
+                },
+                [this]() {
+                    if (!BybitProtocol::onGap(state, kTopic, book)) ++resyncs;
+                });
+        }
+    };
+}
+
+TEST_CASE("A replayed delta burst builds the same book through the pipeline as inline", "[pipeline]") {
+    auto frames = bybit_frames::burst(20000);
+
+    BybitProtocol::State refState;
+    OrderBook reference;
+    for (const auto& frame : frames) BybitProtocol::decode(refState, kTopic, reference, frame, true);
+
+    FramePipeline pipeline(pipelineSettings(frames.size()));
+    BybitChannel bybit(pipeline);
+    pipeline.start();
+    for (const auto& frame : frames) REQUIRE(bybit.channel->push(frame));
+    REQUIRE(waitProcessed(pipeline, frames.size()));
+    pipeline.stop();
+
+    FramePipeline::Stats stats = pipeline.stats();
+    CHECK(stats.dropped == 0);
+    CHECK(stats.pushed == frames.size());
+    CHECK(bybit.resyncs == 0);
+    CHECK(bybit.book.getTopNBids(50) == reference.getTopNBids(50));
+    CHECK(bybit.book.getTopNAsks(50) == reference.getTopNAsks(50));
+    // Batches were applied as single updates
+    CHECK(bybit.book.version() == frames.size() - stats.conflated);
+}
+
+TEST_CASE("Dropped deltas clear the book and request one resync", "[pipeline]") {
+    auto frames = bybit_frames::burst(20);
+
+    // Builders not started yet: the ring fills and the rest of the burst is dropped
+    FramePipeline pipeline(pipelineSettings(8));
+    BybitChannel bybit(pipeline);
+    size_t accepted = 0;
+    for (const auto& frame : frames) accepted += bybit.channel->push(frame);
+    REQUIRE(accepted == 8);
+    CHECK(pipeline.stats().dropped == frames.size() - 8);
+
+    pipeline.start();
+    REQUIRE(waitProcessed(pipeline, 8));
+
+    CHECK(bybit.resyncs == 1);
+    CHECK_FALSE(bybit.state.synced);
+    CHECK(bybit.book.getTop().bid == 0.0);
+
+    // The snapshot the resubscription brings restores the book
+    auto fresh = bybit_frames::burst(3, 500);
+    for (const auto& frame : fresh) REQUIRE(bybit.channel->push(frame));
+    REQUIRE(waitProcessed(pipeline, 8 + fresh.size()));
+    pipeline.stop();
+
+    CHECK(bybit.resyncs == 1);
+    CHECK(bybit.state.synced);
+    CHECK(bybit.book.getTop().bid > 0.0);
+}
@@ -0,0 +1,96 @@
+#include "catch.hpp"
+
+#include "core/Interner.hpp"
+#include "core/RebalanceScheduler.hpp"
+
+#include <string>
+
+namespace {
+    SymbolId sym(const std::string& name) { return static_cast<SymbolId>(symbolTable().intern(name)); }
+
+    OrderBook::TopOfBook top(double bid, double ask) {
+        OrderBook::TopOfBook t;
+        t.bid = bid;
+        t.bidQty = 10.0;
+        t.ask = ask;
+        t.askQty = 10.0;
+        return t;
+    }
+
+    RebalanceSettings settings(double minUnwindUsd, double maxUnwindUsd) {
+        RebalanceSettings s;
+        s.minUnwindUsd = minUnwindUsd;
+        s.maxUnwindUsd = maxUnwindUsd;
+        return s;
+    }
+}
+
+TEST_CASE("An unwind sells the largest long and buys the largest short once the reverse spread pays", "[rebalance]") {
+    RebalanceScheduler scheduler;
+    scheduler.configure(settings(50.0, 0.0));
+    SymbolId symbol = sym("REBALPAIRUSDT");
+    const double positions[] = { 300.0, -200.0, 100.0 };
+    scheduler.onPositions(symbol, positions, 3);
+    const bool valid[] = { true, true, true };
+
+    // Venue 0 bids above venue 1's ask by 0.2%
+    OrderBook::TopOfBook paying[] = { top(100.2, 100.3), top(99.9, 100.0), top(101.0, 101.1) };
+    RebalanceScheduler::Plan plan = scheduler.plan(symbol, paying, valid, 0.1, 1000.0);
+    CHECK(plan.sellIdx == 0);
+    CHECK(plan.buyIdx == 1);
+    CHECK(plan.usd == Approx(200.0));
+    CHECK(plan.spreadPct == Approx(0.2));
+
+    // Below the threshold, crossed the wrong way, or a stale book: no unwind
+    CHECK(scheduler.plan(symbol, paying, valid, 0.25, 1000.0).usd == 0.0);
+    OrderBook::TopOfBook reversed[] = { top(99.8, 99.9), top(99.9, 100.0), top(101.0, 101.1) };
+    CHECK(scheduler.plan(symbol, reversed, valid, 0.0, 1000.0).usd == 0.0);
+    const bool staleShort[] = { true, false, true };
+    CHECK(scheduler.plan(symbol, paying, staleShort, 0.1, 1000.0).usd == 0.0);
+
+    // Nothing to unwind without inventory on both sides
+    const double longOnly[] = { 300.0, 0.0, 100.0 };
+    scheduler.onPositions(symbol, longOnly, 3);
+    CHECK(scheduler.plan(symbol, paying, valid, 0.1, 1000.0).usd == 0.0);
+}
+
+TEST_CASE("maxUnwindUsd caps a single unwind", "[rebalance]") {
+    RebalanceScheduler scheduler;
+    scheduler.configure(settings(50.0, 120.0));
+    SymbolId symbol = sym("REBALCAPUSDT");
+    const double positions[] = { 500.0, -400.0 };
+    scheduler.onPositions(symbol, positions, 2);
+    const bool valid[] = { true, true };
+    OrderBook::TopOfBook tops[] = { top(100.5, 100.6), top(99.9, 100.0) };
+
+    CHECK(scheduler.plan(symbol, tops, valid, 0.1, 1000.0).usd == Approx(120.0));
+    scheduler.configure(settings(50.0, 0.0));
+    CHECK(scheduler.plan(symbol, tops, valid, 0.1, 1000.0).usd == Approx(400.0));
+}
+
+TEST_CASE("Unwinds under minUnwindUsd wait unless the inventory blocks entries", "[rebalance]") {
+    RebalanceScheduler scheduler;
+    scheduler.configure(settings(50.0, 0.0));
+    SymbolId symbol = sym("REBALMINUSDT");
+    const bool valid[] = { true, true };
+    OrderBook::TopOfBook tops[] = { top(100.5, 100.6), top(99.9, 100.0) };
+
+    const double small[] = { 40.0, -30.0 };
+    scheduler.onPositions(symbol, small, 2);
+    CHECK(scheduler.plan(symbol, tops, valid, 0.1, 1000.0).usd == 0.0);
+
+    // The long leaves less than minUnwindUsd of room under maxPosUsd
+    const double full[] = { 980.0, -30.0 };
+    scheduler.onPositions(symbol, full, 2);
+    CHECK(scheduler.plan(symbol, tops, valid, 0.1, 1000.0).usd == Approx(30.0));
+    // So does a short
+    const double shortFull[] = { 40.0, -960.0 };
+    scheduler.onPositions(symbol, shortFull, 2);
+    CHECK(scheduler.plan(symbol, tops, valid, 0.1, 1000.0).usd == Approx(40.0));
+    // With room left, it waits again
+    CHECK(scheduler.plan(symbol, tops, valid, 0.1, 5000.0).usd == 0.0);
+
+    const double enough[] = { 80.0, -60.0 };
+    scheduler.onPositions(symbol, enough, 2);
+    CHECK(scheduler.plan(symbol, tops, valid, 0.1, 5000.0).usd == Approx(60.0));
+}
@@ -0,0 +1,85 @@
+#include "catch.hpp"
+
+#include "common/LatencyHistogram.hpp"
+#include "core/Interner.hpp"
+#include "core/RiskGate.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+// Times RiskGate::check() on two-leg groups with every limit enabled and exposure
+// spread over many symbols; the gate sits on the decision path and must stay sub-microsecond.
+TEST_CASE("The risk gate checks an arbitrage pair in under a microsecond", "[bench][risk]") {
+    RiskLimits limits;
+    limits.maxOrderUsd = 10000.0;
+    limits.maxSymbolGrossUsd = 50000.0;
+    limits.maxSymbolNetUsd = 20000.0;
+    limits.maxGrossUsd = 1e7;
+    limits.maxNetUsd = 1e6;
+    limits.maxLossUsd = 5000.0;
+    limits.duplicateWindowMs = 100.0;
+    limits.rate = { 1e6, 1e6 };
+    limits.venueRates["RiskB"] = { 5e5, 5e5 };
+
+    RiskGate gate;
+    gate.configure(limits);
+
+    constexpr int kSymbols = 300;
+    VenueId venueA = static_cast<VenueId>(venueTable().intern("RiskA"));
+    VenueId venueB = static_cast<VenueId>(venueTable().intern("RiskB"));
+    std::vector<SymbolId> symbols;
+    for (int i = 0; i < kSymbols; ++i) {
+        SymbolId symbol = static_cast<SymbolId>(symbolTable().intern("RISK" + std::to_string(i) + "USDT"));
+        symbols.push_back(symbol);
+        Fill fill;
+        fill.symbol = symbol;
+        fill.venue = venueA;
+        fill.side = Side::Buy;
+        fill.price = 10.0;
+        fill.qty = 100.0;
+        fill.cost = 1000.0;
+        fill.ok = true;
+        gate.onFill(fill);
+    }
+
+    Order buy, sell;
+    buy.venue = venueA;
+    buy.side = Side::Buy;
+    sell.venue = venueB;
+    sell.side = Side::Sell;
+    const Order* legs[] = { &buy, &sell };
+
+    constexpr int kChecks = 200000;
+    LatencyHistogram hist;
+    uint64_t passed = 0;
+    for (int i = 0; i < kChecks; ++i) {
+        buy.symbol = sell.symbol = symbols[i % kSymbols];
+        // Prices repeat every other sweep, so half the groups are rejected as duplicates
+        buy.price = 10.0 + (i / (2 * kSymbols)) * 0.001;
+        sell.price = buy.price + 0.01;
+        buy.qty = sell.qty = 50.0;
+        int64_t t0 = nowNs();
+        RiskReject reject = gate.check(legs, 2, t0);
+        if (reject == RiskReject::None) gate.onSend(legs, 2, t0);
+        hist.record(nowNs() - t0);
+        passed += reject == RiskReject::None;
+    }
+
+    std::printf("risk check+send: n=%llu passed=%llu p50=%lld ns p99=%lld ns p99.9=%lld ns max=%lld ns\n",
+                static_cast<unsigned long long>(hist.count()), static_cast<unsigned long long>(passed),
+                static_cast<long long>(hist.percentile(0.50)), static_cast<long long>(hist.percentile(0.99)),
+                static_cast<long long>(hist.percentile(0.999)), static_cast<long long>(hist.max()));
+
+    CHECK(passed > 0);
+    CHECK(passed < static_cast<uint64_t>(kChecks));
+    CHECK(hist.percentile(0.99) < 1000);
+}
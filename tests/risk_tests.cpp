@@ -0,0 +1,237 @@
+#include "catch.hpp"
+
+#include "core/Interner.hpp"
+#include "core/RiskGate.hpp"
+
+#include <string>
+
+namespace {
+    constexpr int64_t kMs = 1000000;
+    constexpr int64_t kStart = 1000 * kMs;
+
+    SymbolId sym(const std::string& name) { return static_cast<SymbolId>(symbolTable().intern(name)); }
+    VenueId venue(const std::string& name) { return static_cast<VenueId>(venueTable().intern(name)); }
+
+    Order order(SymbolId symbol, VenueId v, Side side, double price, double qty) {
+        Order o;
+        o.symbol = symbol;
+        o.venue = v;
+        o.side = side;
+        o.price = price;
+        o.qty = qty;
+        return o;
+    }
+
+    // Books an executed position of `usd` on the gate.
+    void fill(RiskGate& gate, SymbolId symbol, VenueId v, Side side, double usd) {
+        Fill f;
+        f.symbol = symbol;
+        f.venue = v;
+        f.side = side;
+        f.price = 10.0;
+        f.qty = usd / 10.0;
+        f.cost = usd;
+        f.ok = true;
+        gate.onFill(f);
+    }
+
+    RiskReject check(const RiskGate& gate, const Order& o, int64_t nowNs = kStart) {
+        const Order* legs[] = { &o };
+        return gate.check(legs, 1, nowNs);
+    }
+
+    RiskReject check(const RiskGate& gate, const Order& a, const Order& b, int64_t nowNs = kStart) {
+        const Order* legs[] = { &a, &b };
+        return gate.check(legs, 2, nowNs);
+    }
+
+    void send(RiskGate& gate, const Order& o, int64_t nowNs) {
+        const Order* legs[] = { &o };
+        gate.onSend(legs, 1, nowNs);
+    }
+}
+
+TEST_CASE("Opposite orders on one venue and symbol are refused as a self-trade", "[risk]") {
+    RiskGate gate;
+    gate.configure(RiskLimits{});
+    SymbolId btc = sym("RTSELFUSDT");
+    VenueId a = venue("A"), b = venue("B");
+
+    CHECK(check(gate, order(btc, a, Side::Buy, 10.0, 1.0), order(btc, a, Side::Sell, 10.1, 1.0)) == RiskReject::SelfTrade);
+    CHECK(check(gate, order(btc, a, Side::Buy, 10.0, 1.0), order(btc, b, Side::Sell, 10.1, 1.0)) == RiskReject::None);
+}
+
+TEST_CASE("An order repeating the last one within the duplicate window is refused", "[risk]") {
+    RiskLimits limits;
+    limits.duplicateWindowMs = 100.0;
+    RiskGate gate;
+    gate.configure(limits);
+    SymbolId btc = sym("RTDUPUSDT");
+    VenueId a = venue("A");
+
+    Order buy = order(btc, a, Side::Buy, 10.0, 1.0);
+    REQUIRE(check(gate, buy) == RiskReject::None);
+    send(gate, buy, kStart);
+
+    CHECK(check(gate, buy, kStart + 50 * kMs) == RiskReject::Duplicate);
+    CHECK(check(gate, order(btc, a, Side::Buy, 10.01, 1.0), kStart + 50 * kMs) == RiskReject::None);
+    CHECK(check(gate, order(btc, a, Side::Sell, 10.0, 1.0), kStart + 50 * kMs) == RiskReject::None);
+    CHECK(check(gate, buy, kStart + 150 * kMs) == RiskReject::None);
+}
+
+TEST_CASE("The rate limit allows a burst, then refills at the configured rate", "[risk]") {
+    RiskLimits limits;
+    limits.rate = { 10.0, 2.0 }; // 10 orders/s, 2 at once
+    RiskGate gate;
+    gate.configure(limits);
+    SymbolId btc = sym("RTRATEUSDT");
+    VenueId a = venue("A");
+
+    for (int i = 0; i < 2; ++i) {
+        Order o = order(btc, a, Side::Buy, 10.0 + i, 1.0);
+        REQUIRE(check(gate, o) == RiskReject::None);
+        send(gate, o, kStart);
+    }
+    Order next = order(btc, a, Side::Buy, 20.0, 1.0);
+    CHECK(check(gate, next, kStart) == RiskReject::RateLimit);
+    CHECK(check(gate, next, kStart + 50 * kMs) == RiskReject::RateLimit);
+    // One token back after 100 ms, but a pair on the venue needs two
+    CHECK(check(gate, next, kStart + 100 * kMs) == RiskReject::None);
+    CHECK(check(gate, next, order(sym("RTRATE2USDT"), a, Side::Sell, 5.0, 1.0), kStart + 100 * kMs) ==
+          RiskReject::RateLimit);
+    CHECK(check(gate, next, order(sym("RTRATE2USDT"), a, Side::Sell, 5.0, 1.0), kStart + 200 * kMs) ==
+          RiskReject::None);
+}
+
+TEST_CASE("A venue rate override replaces the default rate", "[risk]") {
+    VenueId slow = venue("B");
+    RiskLimits limits;
+    limits.venueRates["B"] = { 1.0, 1.0 };
+    RiskGate gate;
+    gate.configure(limits);
+    SymbolId btc = sym("RTVENUEUSDT");
+
+    Order o = order(btc, slow, Side::Buy, 10.0, 1.0);
+    send(gate, o, kStart);
+    CHECK(check(gate, order(btc, slow, Side::Buy, 11.0, 1.0), kStart + 500 * kMs) == RiskReject::RateLimit);
+    CHECK(check(gate, order(btc, venue("A"), Side::Buy, 11.0, 1.0), kStart + 500 * kMs) == RiskReject::None);
+}
+
+TEST_CASE("An order over the notional cap is refused", "[risk]") {
+    RiskLimits limits;
+    limits.maxOrderUsd = 1000.0;
+    RiskGate gate;
+    gate.configure(limits);
+    SymbolId btc = sym("RTNOTIONALUSDT");
+    VenueId a = venue("A");
+
+    CHECK(check(gate, order(btc, a, Side::Buy, 100.0, 10.0)) == RiskReject::None);
+    CHECK(check(gate, order(btc, a, Side::Buy, 100.0, 10.1)) == RiskReject::OrderNotional);
+}
+
+TEST_CASE("Symbol gross exposure is capped but can always be reduced", "[risk]") {
+    RiskLimits limits;
+    limits.maxSymbolGrossUsd = 1500.0;
+    RiskGate gate;
+    gate.configure(limits);
+    SymbolId btc = sym("RTSGROSSUSDT");
+    VenueId a = venue("A"), b = venue("B");
+    fill(gate, btc, a, Side::Buy, 1000.0);
+
+    // An arbitrage pair adds both legs to the symbol's gross
+    CHECK(check(gate, order(btc, b, Side::Buy, 10.0, 30.0), order(btc, a, Side::Sell, 10.0, 30.0)) == RiskReject::None);
+    CHECK(check(gate, order(btc, b, Side::Buy, 10.0, 60.0)) == RiskReject::SymbolGross);
+    CHECK(check(gate, order(btc, b, Side::Sell, 10.0, 30.0), order(btc, a, Side::Buy, 10.0, 30.0)) ==
+          RiskReject::SymbolGross);
+    // Selling the long down, or past flat by less than it was, grows nothing
+    CHECK(check(gate, order(btc, a, Side::Sell, 10.0, 100.0)) == RiskReject::None);
+    CHECK(check(gate, order(btc, a, Side::Sell, 10.0, 150.0)) == RiskReject::None);
+
+    // Over the limit after it was lowered: unwinds still pass
+    limits.maxSymbolGrossUsd = 500.0;
+    gate.configure(limits);
+    CHECK(check(gate, order(btc, b, Side::Buy, 10.0, 1.0)) == RiskReject::SymbolGross);
+    CHECK(check(gate, order(btc, a, Side::Sell, 10.0, 40.0)) == RiskReject::None);
+}
+
+TEST_CASE("Symbol net exposure is capped but hedges and unwinds pass", "[risk]") {
+    RiskLimits limits;
+    limits.maxSymbolNetUsd = 500.0;
+    RiskGate gate;
+    gate.configure(limits);
+    SymbolId eth = sym("RTSNETUSDT");
+    VenueId a = venue("A"), b = venue("B");
+    fill(gate, eth, a, Side::Buy, 400.0);
+
+    CHECK(check(gate, order(eth, b, Side::Buy, 10.0, 20.0)) == RiskReject::SymbolNet);
+    // A hedged pair leaves net where it is
+    CHECK(check(gate, order(eth, b, Side::Buy, 10.0, 50.0), order(eth, a, Side::Sell, 10.0, 50.0)) == RiskReject::None);
+
+    limits.maxSymbolNetUsd = 300.0;
+    gate.configure(limits);
+    CHECK(check(gate, order(eth, b, Side::Buy, 10.0, 1.0)) == RiskReject::SymbolNet);
+    CHECK(check(gate, order(eth, b, Side::Sell, 10.0, 10.0)) == RiskReject::None);
+}
+
+TEST_CASE("Global gross and net limits span symbols and let unwinds through", "[risk]") {
+    RiskLimits limits;
+    limits.maxGrossUsd = 1500.0;
+    limits.maxNetUsd = 1200.0;
+    RiskGate gate;
+    gate.configure(limits);
+    SymbolId x = sym("RTGLOBALXUSDT"), y = sym("RTGLOBALYUSDT");
+    VenueId a = venue("A"), b = venue("B");
+    fill(gate, x, a, Side::Buy, 1000.0);
+    CHECK(gate.grossUsd() == Approx(1000.0));
+    CHECK(gate.netUsd() == Approx(1000.0));
+
+    CHECK(check(gate, order(y, a, Side::Buy, 10.0, 30.0)) == RiskReject::GlobalNet);
+    CHECK(check(gate, order(y, a, Side::Buy, 10.0, 30.0), order(y, b, Side::Sell, 10.0, 30.0)) ==
+          RiskReject::GlobalGross);
+    CHECK(check(gate, order(y, a, Side::Buy, 10.0, 20.0), order(y, b, Side::Sell, 10.0, 20.0)) == RiskReject::None);
+    CHECK(check(gate, order(x, a, Side::Sell, 10.0, 100.0)) == RiskReject::None);
+
+    fill(gate, y, b, Side::Sell, 400.0);
+    CHECK(gate.grossUsd() == Approx(1400.0));
+    CHECK(gate.netUsd() == Approx(600.0));
+    limits.maxGrossUsd = 1000.0;
+    gate.configure(limits);
+    CHECK(check(gate, order(x, b, Side::Sell, 10.0, 10.0)) == RiskReject::GlobalGross);
+    CHECK(check(gate, order(y, b, Side::Buy, 10.0, 10.0)) == RiskReject::None);
+}
+
+TEST_CASE("The kill switch trips on realized losses and blocks everything until reset", "[risk]") {
+    RiskLimits limits;
+    limits.maxLossUsd = 100.0;
+    RiskGate gate;
+    gate.configure(limits);
+    SymbolId btc = sym("RTKILLUSDT");
+    VenueId a = venue("A");
+    fill(gate, btc, a, Side::Buy, 500.0);
+
+    gate.onPnl(-60.0);
+    gate.onPnl(20.0);
+    CHECK_FALSE(gate.killed());
+    gate.onPnl(-60.0);
+    REQUIRE(gate.killed());
+    CHECK(gate.pnl() == Approx(-100.0));
+    CHECK(check(gate, order(btc, a, Side::Buy, 10.0, 1.0)) == RiskReject::KillSwitch);
+    CHECK(check(gate, order(btc, a, Side::Sell, 10.0, 1.0)) == RiskReject::KillSwitch);
+
+    gate.resetKillSwitch();
+    CHECK(check(gate, order(btc, a, Side::Sell, 10.0, 1.0)) == RiskReject::None);
+    // Still past the limit: reapplying limits trips it again
+    gate.configure(limits);
+    CHECK(gate.killed());
+}
+
+TEST_CASE("Rejections are counted by reason", "[risk]") {
+    RiskGate gate;
+    gate.countReject(RiskReject::Duplicate);
+    gate.countReject(RiskReject::Duplicate);
+    gate.countReject(RiskReject::SelfTrade);
+    CHECK(gate.rejects(RiskReject::Duplicate) == 2);
+    CHECK(gate.rejects(RiskReject::SelfTrade) == 1);
+    CHECK(gate.rejects(RiskReject::RateLimit) == 0);
+    CHECK(std::string(riskRejectName(RiskReject::GlobalNet)) == "global_net");
+}
@@ -0,0 +1,118 @@
+#include "catch.hpp"
+#include "TestVenue.hpp"
+
+#include "common/ConfigManager.hpp"
+#include "core/ArbitrageEngine.hpp"
+#include "core/StartupSequence.hpp"
+#include "exchange/InstrumentCatalog.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::string coin(int i) {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "C%03d", i);
+        return buf;
+    }
+
+    // exchangeInfo with perpetuals C000..C(count-1) USDT, plus a quarterly future that is skipped.
+    std::string binanceInfo(int first, int count) {
+        std::string symbols;
+        for (int i = first; i < first + count; ++i) {
+            symbols += R"({"symbol":")" + coin(i) + R"(USDT","contractType":"PERPETUAL","status":"TRADING",)"
+                       R"("quoteAsset":"USDT","filters":[{"filterType":"PRICE_FILTER","tickSize":"0.001"},)"
+                       R"({"filterType":"LOT_SIZE","stepSize":"0.1"}]},)";
+        }
+        symbols += R"({"symbol":"C000USDT_250926","contractType":"CURRENT_QUARTER","status":"TRADING","quoteAsset":"USDT"})";
+        return R"({"symbols":[)" + symbols + "]}";
+    }
+
+    std::string bybitInfo(int first, int count) {
+        std::string list;
+        for (int i = first; i < first + count; ++i) {
+            list += (i > first ? "," : "") + std::string(R"({"symbol":")") + coin(i) +
+                    R"(USDT","contractType":"LinearPerpetual","status":"Trading","quoteCoin":"USDT",)"
+                    R"("priceFilter":{"tickSize":"0.001"},"lotSizeFilter":{"qtyStep":"0.1"}})";
+        }
+        return R"({"retCode":0,"result":{"list":[)" + list + R"(],"nextPageCursor":""}})";
+    }
+
+    std::string writeFixture(const std::string& name, const std::string& body) {
+        std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream(path) << body;
+        return path;
+    }
+
+    // Socket stand-in: each batch of symbols "connects" after a delay, then every
+    // book in it receives its first snapshot.
+    void feedFirstBooks(TestVenue& venue, const std::vector<std::string>& symbols, size_t batch,
+                        std::chrono::milliseconds connectDelay) {
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            if (i % batch == 0) std::this_thread::sleep_for(connectDelay);
+            venue.setTop(symbols[i], 1.00, 10.0, 1.01, 10.0);
+        }
+    }
+}
+
+// Time from launch to ready-to-trade for a universe of 300+ symbols on two venues:
+// discovery from instrument fixtures, subscription, the book readiness barrier,
+// engine preparation and warm-up. It should stay in the low seconds.
+TEST_CASE("A 320-symbol universe is ready to trade within seconds of launch", "[bench][startup]") {
+    StartupSequence startup;
+
+    UniverseSettings settings;
+    settings.enabled = true;
+    settings.binanceFixture = writeFixture("startup_bench_binance.json", binanceInfo(0, 340));
+    settings.bybitFixture = writeFixture("startup_bench_bybit.json", bybitInfo(20, 330));
+    Universe universe = InstrumentCatalog::discover(settings, "", "");
+    startup.phase("discovery");
+    std::filesystem::remove(settings.binanceFixture);
+    std::filesystem::remove(settings.bybitFixture);
+    REQUIRE(universe.symbols.size() == 320);
+
+    ConfigSnapshot cfg;
+    cfg.symbols = universe.symbols;
+    cfg.minSpreadPercent = 50.0; // Books never cross
+    cfg.statsLogIntervalSec = 0.0;
+    ConfigManager::publish(cfg);
+
+    auto a = std::make_shared<TestVenue>("StartA");
+    auto b = std::make_shared<TestVenue>("StartB");
+    std::vector<std::shared_ptr<IExchangeClient>> clients = { a, b };
+    StartupSequence::subscribeAll(clients, cfg.symbols);
+    startup.phase("subscribe");
+
+    // 50 symbols per socket, each socket's first snapshot ~20 ms after subscribing
+    std::thread feedA(feedFirstBooks, std::ref(*a), std::cref(cfg.symbols), 50, std::chrono::milliseconds(20));
+    std::thread feedB(feedFirstBooks, std::ref(*b), std::cref(cfg.symbols), 50, std::chrono::milliseconds(20));
+    StartupSequence::Readiness ready = StartupSequence::waitForBooks(clients, cfg.symbols, 10.0);
+    startup.phase("books");
+    feedA.join();
+    feedB.join();
+
+    ArbitrageEngine engine;
+    engine.addExchangeClient(a);
+    engine.addExchangeClient(b);
+    for (const auto& symbol : universe.symbols) {
+        engine.setLotSize("StartA", symbol, universe.binance.at(symbol).lotSize);
+        engine.setLotSize("StartB", symbol, universe.bybit.at(symbol).lotSize);
+    }
+    engine.prepare();
+    startup.phase("prepare");
+    engine.warmUp(100);
+    startup.phase("warmup");
+    startup.logSummary();
+
+    double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startup.launch()).count();
+    std::printf("startup: %zu symbols x 2 venues, %zu/%zu books ready, ready to trade after %.1f ms\n",
+                universe.symbols.size(), ready.ready, ready.total, totalMs);
+
+    CHECK(ready.ready == ready.total);
+    CHECK(totalMs < 3000.0);
+}
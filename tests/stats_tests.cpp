@@ -0,0 +1,152 @@
+#include "catch.hpp"
+#include "TestVenue.hpp"
+
+#include "common/ConfigManager.hpp"
+#include "core/ArbitrageEngine.hpp"
+#include "core/PaperTrader.hpp"
+#include "core/SpreadStats.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr int64_t kMs = 1000000;
+
+    // Exact p-quantile of `v` (nearest rank).
+    double exactQuantile(std::vector<double> v, double p) {
+        auto nth = v.begin() + static_cast<std::ptrdiff_t>(p * static_cast<double>(v.size() - 1));
+        std::nth_element(v.begin(), nth, v.end());
+        return *nth;
+    }
+
+    // Buy-A/sell-B position after `quiet` scans at a 0.05% spread and one at 0.5%,
+    // with an adaptive threshold of the quiet spread's mean plus ten standard deviations.
+    double positionAfterSpike(uint64_t minSamples, int quiet, uint64_t& samples) {
+        ConfigSnapshot cfg;
+        cfg.symbols = { "ADAPTUSDT" };
+        cfg.minSpreadPercent = 0.1;
+        cfg.adaptiveThreshold = true;
+        cfg.adaptiveStddevMult = 10.0;
+        cfg.adaptiveMinSamples = minSamples;
+        cfg.statsLogIntervalSec = 0.0;
+        ConfigManager::publish(cfg);
+
+        auto a = std::make_shared<TestVenue>("A");
+        auto b = std::make_shared<TestVenue>("B");
+        a->subscribeOrderBooks(cfg.symbols);
+        b->subscribeOrderBooks(cfg.symbols);
+        ArbitrageEngine engine;
+        engine.addExchangeClient(a);
+        engine.addExchangeClient(b);
+        engine.addExecutor("A", std::make_shared<PaperTrader>("A", 0.0));
+        engine.addExecutor("B", std::make_shared<PaperTrader>("B", 0.0));
+        engine.prepare();
+
+        // Every scan sees a new book version, so each adds one sample
+        for (int i = 0; i < quiet; ++i) {
+            a->setTop("ADAPTUSDT", 99.9, 1.0, 100.0, 1.0 + (i % 2));
+            b->setTop("ADAPTUSDT", 100.05, 1.0, 100.2, 1.0);
+            engine.scan();
+        }
+        b->setTop("ADAPTUSDT", 100.5, 1.0, 100.6, 1.0);
+        engine.scan();
+
+        SymbolId symbol = static_cast<SymbolId>(symbolTable().intern("ADAPTUSDT"));
+        VenueId venueA = static_cast<VenueId>(venueTable().intern("A"));
+        samples = engine.spreadStats(symbol, venueA, static_cast<VenueId>(venueTable().intern("B"))).samples;
+        return engine.positions(symbol).usd[venueA];
+    }
+}
+
+TEST_CASE("P2 quantile estimates track the exact quantiles of a known distribution", "[stats]") {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    P2Quantile p50(0.50), p90(0.90), p99(0.99);
+    P2Quantile u90(0.90);
+    std::vector<double> seen;
+    for (int i = 0; i < 100000; ++i) {
+        double x = normal(rng);
+        seen.push_back(x);
+        p50.add(x);
+        p90.add(x);
+        p99.add(x);
+        u90.add(uniform(rng));
+    }
+
+    CHECK(p50.value() == Approx(exactQuantile(seen, 0.50)).margin(0.02));
+    CHECK(p90.value() == Approx(exactQuantile(seen, 0.90)).margin(0.02));
+    CHECK(p99.value() == Approx(exactQuantile(seen, 0.99)).margin(0.05));
+    // And the population's (N(0,1): 0, 1.2816, 2.3263; U(0,1): 0.9)
+    CHECK(p50.value() == Approx(0.0).margin(0.02));
+    CHECK(p90.value() == Approx(1.2816).margin(0.02));
+    CHECK(p99.value() == Approx(2.3263).margin(0.05));
+    CHECK(u90.value() == Approx(0.9).margin(0.01));
+}
+
+TEST_CASE("P2 quantile is exact below five samples", "[stats]") {
+    P2Quantile median(0.5);
+    CHECK(median.value() == 0.0);
+    median.add(3.0);
+    median.add(1.0);
+    median.add(2.0);
+    CHECK(median.value() == 2.0);
+}
+
+TEST_CASE("Spread EWMA and variance follow the exponential recurrence", "[stats]") {
+    SpreadStats stats(0.1);
+    stats.update(0.0, 1.0, kMs);
+    CHECK(stats.ewma() == 0.0);
+    CHECK(stats.variance() == 0.0);
+
+    // One step of 1: mean moves alpha toward it, variance is alpha * (1 - alpha) * step^2
+    stats.update(1.0, 1.0, 2 * kMs);
+    CHECK(stats.ewma() == Approx(0.1));
+    CHECK(stats.variance() == Approx(0.1 * 0.9));
+    stats.update(1.0, 1.0, 3 * kMs);
+    CHECK(stats.ewma() == Approx(0.19));
+    CHECK(stats.variance() == Approx(0.9 * (0.09 + 0.9 * 0.09)));
+
+    // Alternating 0 and 2 settles at mean 1, standard deviation 1
+    SpreadStats alternating(0.01);
+    for (int i = 0; i < 5000; ++i) alternating.update(i % 2 ? 2.0 : 0.0, 5.0, (i + 1) * kMs);
+    CHECK(alternating.ewma() == Approx(1.0).margin(0.02));
+    CHECK(alternating.stddev() == Approx(1.0).margin(0.02));
+    CHECK(alternating.samples() == 5000);
+
+    SpreadStats flat;
+    for (int i = 0; i < 100; ++i) flat.update(0.3, 1.0, (i + 1) * kMs);
+    CHECK(flat.ewma() == Approx(0.3));
+    CHECK(flat.stddev() == Approx(0.0).margin(1e-9));
+}
+
+TEST_CASE("Opportunity episodes are timed from the first sample above the threshold", "[stats]") {
+    SpreadStats stats;
+    stats.update(0.5, 1.0, 1 * kMs);
+    stats.update(1.5, 1.0, 10 * kMs);  // Opens
+    stats.update(2.0, 1.0, 20 * kMs);
+    stats.update(1.0, 1.0, 40 * kMs);  // At the threshold is not above it: closes after 30 ms
+    stats.update(2.0, 1.0, 50 * kMs);
+    stats.update(0.2, 1.0, 55 * kMs);  // 5 ms
+    stats.update(3.0, 1.0, 60 * kMs);  // Still open
+
+    SpreadStatsSnapshot snap = stats.snapshot(100 * kMs);
+    CHECK(snap.samples == 7);
+    CHECK(snap.last == 3.0);
+    CHECK(snap.opportunities == 2);
+    CHECK(snap.avgOpportunityMs == Approx(17.5));
+    CHECK(snap.maxOpportunityMs == Approx(30.0));
+    CHECK(snap.openOpportunityMs == Approx(40.0));
+}
+
+TEST_CASE("The adaptive threshold applies only after minSamples observations", "[stats]") {
+    uint64_t samples = 0;
+    // Too few samples: the spike clears the static 0.1% threshold and trades
+    CHECK(positionAfterSpike(100, 49, samples) > 0.0);
+    CHECK(samples == 50);
+    // Enough: the threshold is ewma + 10 stddev, above the spike
+    CHECK(positionAfterSpike(50, 49, samples) == 0.0);
+    CHECK(samples == 50);
+}
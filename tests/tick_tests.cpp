@@ -0,0 +1,158 @@
+#include "catch.hpp"
+
+#include "core/Interner.hpp"
+#include "storage/TickFormat.hpp"
+#include "storage/TickStore.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include <sys/resource.h>
+
+namespace {
+    template <typename Pred>
+    bool waitFor(Pred done) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!done()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    // Number of chunks a reader can walk, and whether it consumed the whole file.
+    size_t readableChunks(const std::string& path, bool& complete) {
+        std::ifstream in(path, std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        tickfmt::ChunkReader reader(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        tickfmt::ChunkView chunk;
+        size_t chunks = 0, bytes = 0;
+        while (reader.next(chunk)) {
+            ++chunks;
+            bytes += sizeof(tickfmt::ChunkHeader) + chunk.header.payloadSize;
+        }
+        complete = bytes == data.size();
+        return chunks;
+    }
+}
+
+TEST_CASE("A chunk that fails to write is cut back off the file", "[tickstore]") {
+    auto dir = std::filesystem::temp_directory_path() / "tick_tests";
+    std::filesystem::remove_all(dir);
+
+    TickStoreSettings settings;
+    settings.dir = dir.string();
+    settings.chunkRows = 4;
+    settings.flushIntervalSec = 3600.0;
+    settings.compress = false;
+    TickStore store(settings);
+    store.start();
+
+    SymbolId symbol = static_cast<SymbolId>(symbolTable().intern("TICKUSDT"));
+    VenueId venue = static_cast<VenueId>(venueTable().intern("TickVenue"));
+    auto chunk = [&](double price) {
+        for (int i = 0; i < 4; ++i) store.recordTop(symbol, venue, price + i, 1.0, price + i + 0.5, 2.0);
+    };
+
+    chunk(100.0);
+    REQUIRE(waitFor([&] { return store.written() == 4; }));
+    std::string path;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+        if (entry.is_regular_file()) path = entry.path().string();
+    }
+    REQUIRE(!path.empty());
+    auto goodSize = std::filesystem::file_size(path);
+
+    // The file size limit lets only part of the next chunk through
+    rlimit saved{};
+    getrlimit(RLIMIT_FSIZE, &saved);
+    rlimit limited = saved;
+    limited.rlim_cur = goodSize + 16;
+    auto savedHandler = std::signal(SIGXFSZ, SIG_IGN);
+    setrlimit(RLIMIT_FSIZE, &limited);
+    chunk(200.0);
+    bool failed = waitFor([&] { return store.dropped() == 4; });
+    setrlimit(RLIMIT_FSIZE, &saved);
+    std::signal(SIGXFSZ, savedHandler);
+    REQUIRE(failed);
+    CHECK(std::filesystem::file_size(path) == goodSize);
+
+    // Later chunks follow the last complete one and stay readable
+    chunk(300.0);
+    REQUIRE(waitFor([&] { return store.written() == 8; }));
+    store.stop();
+
+    bool complete = false;
+    CHECK(readableChunks(path, complete) == 2);
+    CHECK(complete);
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Stopping the store writes the rows still queued and buffered", "[tickstore]") {
+    auto dir = std::filesystem::temp_directory_path() / "tick_tests_stop";
+    std::filesystem::remove_all(dir);
+
+    TickStoreSettings settings;
+    settings.dir = dir.string();
+    settings.chunkRows = 1024;
+    settings.flushIntervalSec = 3600.0; // Nothing reaches disk before stop()
+    settings.compress = true;
+    TickStore store(settings);
+    SymbolId symbol = static_cast<SymbolId>(symbolTable().intern("TICKSTOPUSDT"));
+    VenueId venue = static_cast<VenueId>(venueTable().intern("TickVenue"));
+    VenueId other = static_cast<VenueId>(venueTable().intern("A"));
+    store.prepare({ symbol });
+    store.start();
+
+    constexpr int kRows = 100;
+    for (int i = 0; i < kRows; ++i) {
+        store.recordTop(symbol, venue, 100.0 + i * 0.25, 1.5, 100.5 + i * 0.25, 2.0 + i);
+        store.recordSpread(symbol, venue, other, 0.01 * i);
+    }
+    store.stop();
+    CHECK(store.written() == 2 * kRows);
+    CHECK(store.dropped() == 0);
+
+    // Each table comes back as one chunk holding every row in order
+    auto readTable = [&](const char* table, tickfmt::Columns& columns, std::vector<std::string>& venues) {
+        std::string path;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+            if (entry.path().filename() == std::string("TICKSTOPUSDT.") + table + ".tks") path = entry.path().string();
+        }
+        REQUIRE(!path.empty());
+        std::ifstream in(path, std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        tickfmt::ChunkReader reader(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        tickfmt::ChunkView chunk;
+        REQUIRE(reader.next(chunk));
+        CHECK(chunk.header.rows == kRows);
+        std::string scratch;
+        REQUIRE(tickfmt::decodeChunk(chunk, columns, venues, scratch));
+        CHECK_FALSE(reader.next(chunk));
+    };
+
+    tickfmt::Columns bbo;
+    std::vector<std::string> venues;
+    readTable("bbo", bbo, venues);
+    REQUIRE(bbo[tickfmt::kBboBid].size() == kRows);
+    // Rows index the venue table stored with the chunk
+    CHECK(venues.at(bbo[tickfmt::kBboVenue][0]) == "TickVenue");
+    for (int i = 0; i < kRows; ++i) {
+        INFO(i);
+        CHECK(bbo[tickfmt::kBboBid][i] == tickfmt::toFixed(100.0 + i * 0.25, tickfmt::kPriceScale));
+        CHECK(bbo[tickfmt::kBboAskQty][i] == tickfmt::toFixed(2.0 + i, tickfmt::kPriceScale));
+        if (i > 0) CHECK(bbo[tickfmt::kBboTs][i] >= bbo[tickfmt::kBboTs][i - 1]);
+    }
+
+    tickfmt::Columns spread;
+    readTable("spread", spread, venues);
+    CHECK(venues.at(spread[tickfmt::kSpreadBuy][0]) == "TickVenue");
+    CHECK(venues.at(spread[tickfmt::kSpreadSell][0]) == "A");
+    CHECK(spread[tickfmt::kSpreadPct][kRows - 1] == tickfmt::toFixed(0.01 * (kRows - 1), tickfmt::kSpreadScale));
+    std::filesystem::remove_all(dir);
+}
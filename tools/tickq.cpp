@@ -0,0 +1,302 @@
+// tickq: time-range and percentile queries over tick store files.
+//
+//   tickq [options] FILE...
+//     --from T, --to T   UTC time range; epoch seconds or YYYY-MM-DD[THH:MM[:SS]]
+//     --column NAME      bbo files: mid (default), bid, ask, bidQty, askQty, spreadBps
+//                        spread files: spread (default)
+//     --venue NAME       bbo: rows of this venue only; spread: this buy venue only
+//     --sell NAME        spread: this sell venue only
+//     --pct LIST         Comma-separated percentiles (default 50,90,99,99.9)
+//     --dump             Print matching rows as CSV instead of statistics
+//
+// Files are memory-mapped; chunks outside the time range are skipped from their headers.
+
+#include "storage/TickFormat.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace tickfmt;
+
+namespace {
+    struct Options {
+        int64_t fromUs = std::numeric_limits<int64_t>::min();
+        int64_t toUs = std::numeric_limits<int64_t>::max();
+        std::string column;
+        std::string venue;
+        std::string sell;
+        std::vector<double> percentiles{ 50, 90, 99, 99.9 };
+        bool dump = false;
+        std::vector<std::string> files;
+    };
+
+    struct Totals {
+        size_t files = 0;
+        size_t chunks = 0;
+        size_t skippedChunks = 0;
+        size_t decodedRows = 0;
+        int64_t firstUs = std::numeric_limits<int64_t>::max();
+        int64_t lastUs = std::numeric_limits<int64_t>::min();
+        std::vector<double> values;
+    };
+
+    void usage() {
+        std::fprintf(stderr,
+                     "usage: tickq [--from T] [--to T] [--column NAME] [--venue NAME] [--sell NAME]\n"
+                     "             [--pct 50,90,99] [--dump] FILE...\n"
+                     "  T: epoch seconds or YYYY-MM-DD[THH:MM[:SS]] (UTC)\n");
+    }
+
+    bool parseTime(const char* text, int64_t& us) {
+        char* end = nullptr;
+        double secs = std::strtod(text, &end);
+        if (end && *end == '\0' && end != text) {
+            us = static_cast<int64_t>(secs * 1e6);
+            return true;
+        }
+        for (const char* fmt : { "%Y-%m-%dT%H:%M:%S", "%Y-%m-%dT%H:%M", "%Y-%m-%d" }) {
+            std::tm tm{};
+            const char* rest = strptime(text, fmt, &tm);
+            if (rest && *rest == '\0') {
+                us = static_cast<int64_t>(timegm(&tm)) * 1000000;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string formatTime(int64_t us) {
+        std::time_t t = static_cast<std::time_t>(us / 1000000);
+        std::tm tm{};
+        gmtime_r(&t, &tm);
+        char buf[32];
+        std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tm);
+        char frac[16];
+        std::snprintf(frac, sizeof(frac), ".%06lldZ", static_cast<long long>(us % 1000000));
+        return std::string(buf) + frac;
+    }
+
+    // Value of the requested column for row r; NaN if the row has no such value.
+    double columnValue(Table table, const std::string& column, const Columns& c, size_t r) {
+        if (table == Table::Spread) return c[kSpreadPct][r] / kSpreadScale;
+
+        double bid = c[kBboBid][r] / kPriceScale;
+        double ask = c[kBboAsk][r] / kPriceScale;
+        if (column == "bid") return bid;
+        if (column == "ask") return ask;
+        if (column == "bidQty") return c[kBboBidQty][r] / kPriceScale;
+        if (column == "askQty") return c[kBboAskQty][r] / kPriceScale;
+        if (bid <= 0.0 || ask <= 0.0) return std::nan("");
+        if (column == "spreadBps") return (ask - bid) / ((ask + bid) / 2.0) * 1e4;
+        return (bid + ask) / 2.0; // mid
+    }
+
+    bool validColumn(Table table, const std::string& column) {
+        if (table == Table::Spread) return column.empty() || column == "spread";
+        static const char* names[] = { "", "mid", "bid", "ask", "bidQty", "askQty", "spreadBps" };
+        return std::find(std::begin(names), std::end(names), column) != std::end(names);
+    }
+
+    // Index of `name` in a chunk's venue table, -1 if absent, or -2 if no filter was given.
+    int64_t venueIndex(const std::vector<std::string>& venues, const std::string& name) {
+        if (name.empty()) return -2;
+        auto it = std::find(venues.begin(), venues.end(), name);
+        return it == venues.end() ? -1 : it - venues.begin();
+    }
+
+    bool queryFile(const std::string& path, const Options& opt, Totals& totals) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::fprintf(stderr, "tickq: cannot open %s: %s\n", path.c_str(), std::strerror(errno));
+            return false;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return st.st_size == 0;
+        }
+        size_t size = static_cast<size_t>(st.st_size);
+        void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            std::fprintf(stderr, "tickq: cannot map %s: %s\n", path.c_str(), std::strerror(errno));
+            return false;
+        }
+        ::madvise(map, size, MADV_SEQUENTIAL);
+
+        ChunkReader reader(static_cast<const uint8_t*>(map), size);
+        ChunkView chunk;
+        Columns cols;
+        std::vector<std::string> venues;
+        std::string scratch;
+        bool ok = true;
+        size_t consumed = 0;
+
+        while (reader.next(chunk)) {
+            consumed += sizeof(ChunkHeader) + chunk.header.payloadSize;
+            ++totals.chunks;
+            const ChunkHeader& h = chunk.header;
+            if (h.maxTsUs < opt.fromUs || h.minTsUs > opt.toUs) {
+                ++totals.skippedChunks;
+                continue;
+            }
+            Table table = static_cast<Table>(h.table);
+            if (!validColumn(table, opt.column)) {
+                std::fprintf(stderr, "tickq: column '%s' does not exist in %s\n", opt.column.c_str(), path.c_str());
+                ok = false;
+                break;
+            }
+            if (!decodeChunk(chunk, cols, venues, scratch)) {
+                std::fprintf(stderr, "tickq: corrupt chunk in %s\n", path.c_str());
+                ok = false;
+                break;
+            }
+            totals.decodedRows += h.rows;
+
+            int64_t venue = venueIndex(venues, opt.venue);
+            int64_t sell = venueIndex(venues, opt.sell);
+            if (venue == -1 || sell == -1) continue;
+
+            const size_t venueCol = table == Table::Bbo ? kBboVenue : kSpreadBuy;
+            for (size_t r = 0; r < h.rows; ++r) {
+                int64_t ts = cols[0][r];
+                if (ts < opt.fromUs || ts > opt.toUs) continue;
+                if (venue >= 0 && cols[venueCol][r] != venue) continue;
+                if (sell >= 0 && (table != Table::Spread || cols[kSpreadSell][r] != sell)) continue;
+
+                double v = columnValue(table, opt.column, cols, r);
+                if (std::isnan(v)) continue;
+                totals.firstUs = std::min(totals.firstUs, ts);
+                totals.lastUs = std::max(totals.lastUs, ts);
+
+                if (opt.dump) {
+                    auto name = [&](int64_t idx) {
+                        return idx >= 0 && static_cast<size_t>(idx) < venues.size() ? venues[idx].c_str() : "?";
+                    };
+                    if (table == Table::Bbo) {
+                        std::printf("%s,%s,%.8f,%.8f,%.8f,%.8f\n", formatTime(ts).c_str(), name(cols[kBboVenue][r]),
+                                    cols[kBboBid][r] / kPriceScale, cols[kBboBidQty][r] / kPriceScale,
+                                    cols[kBboAsk][r] / kPriceScale, cols[kBboAskQty][r] / kPriceScale);
+                    } else {
+                        std::printf("%s,%s,%s,%.6f\n", formatTime(ts).c_str(), name(cols[kSpreadBuy][r]),
+                                    name(cols[kSpreadSell][r]), v);
+                    }
+                } else {
+                    totals.values.push_back(v);
+                }
+            }
+        }
+        if (ok && consumed != size) {
+            std::fprintf(stderr, "tickq: %s has %zu trailing bytes (truncated chunk?)\n", path.c_str(), size - consumed);
+        }
+
+        ::munmap(map, size);
+        ++totals.files;
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                usage();
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--from" || arg == "--to") {
+            const char* text = value();
+            if (!parseTime(text, arg == "--from" ? opt.fromUs : opt.toUs)) {
+                std::fprintf(stderr, "tickq: bad time '%s'\n", text);
+                return 2;
+            }
+        } else if (arg == "--column") {
+            opt.column = value();
+        } else if (arg == "--venue") {
+            opt.venue = value();
+        } else if (arg == "--sell") {
+            opt.sell = value();
+        } else if (arg == "--pct") {
+            opt.percentiles.clear();
+            std::string list = value();
+            for (size_t pos = 0; pos < list.size();) {
+                size_t comma = list.find(',', pos);
+                if (comma == std::string::npos) comma = list.size();
+                opt.percentiles.push_back(std::strtod(list.substr(pos, comma - pos).c_str(), nullptr));
+                pos = comma + 1;
+            }
+        } else if (arg == "--dump") {
+            opt.dump = true;
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            opt.files.push_back(arg);
+        }
+    }
+    if (opt.files.empty()) {
+        usage();
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Totals totals;
+    bool ok = true;
+    for (const auto& file : opt.files) ok &= queryFile(file, opt, totals);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (opt.dump) return ok ? 0 : 1;
+
+    std::printf("files=%zu chunks=%zu skipped=%zu decoded=%zu rows in %.1fms (%.1fM rows/s)\n", totals.files,
+                totals.chunks, totals.skippedChunks, totals.decodedRows, elapsedMs,
+                elapsedMs > 0.0 ? totals.decodedRows / elapsedMs / 1e3 : 0.0);
+
+    auto& v = totals.values;
+    if (v.empty()) {
+        std::printf("no matching rows\n");
+        return ok ? 0 : 1;
+    }
+
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    auto [lo, hi] = std::minmax_element(v.begin(), v.end());
+    std::printf("rows=%zu from=%s to=%s\n", v.size(), formatTime(totals.firstUs).c_str(),
+                formatTime(totals.lastUs).c_str());
+    std::printf("%s: min=%.8g mean=%.8g max=%.8g\n", opt.column.empty() ? "value" : opt.column.c_str(), *lo,
+                sum / v.size(), *hi);
+
+    // Nearest-rank percentiles; ascending order lets each search narrow the range.
+    std::vector<double> pcts = opt.percentiles;
+    std::sort(pcts.begin(), pcts.end());
+    auto first = v.begin();
+    for (double p : pcts) {
+        p = std::clamp(p, 0.0, 100.0);
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * v.size()));
+        auto nth = v.begin() + (rank > 0 ? rank - 1 : 0);
+        if (nth < first) nth = first;
+        std::nth_element(first, nth, v.end());
+        std::printf("p%g=%.8g\n", p, *nth);
+        first = nth;
+    }
+    return ok ? 0 : 1;
+}